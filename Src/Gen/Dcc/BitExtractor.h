@@ -132,9 +132,107 @@ namespace dcc
     {
       INVALID_HALFBIT = 0,
       SHORT_HALFBIT = 1,
-      LONG_HALFBIT = 2
+      LONG_HALFBIT = 2,
+      HALFBIT_MAX_COUNT = 3
     } eHalfBit;
 
+    /**
+     * @brief Bit events that are forwarded to the packet extractor after a state transition.
+     */
+    typedef enum
+    {
+      EVENT_NONE          = 0,      ///< No event (first half of a bit)
+      EVENT_ONE           = 1,      ///< packet_extractor.one()
+      EVENT_ZERO          = 2,      ///< packet_extractor.zero()
+      EVENT_INVALID       = 3,      ///< packet_extractor.invalid()
+      EVENT_MAX_COUNT     = 4       ///< Maximum number of events
+    } eEvent;
+
+    /**
+     * @brief State transition map: next state for [current state][received half bit].
+     */
+    static constexpr uint8 kTransitionMap[STATE_MAX_COUNT][HALFBIT_MAX_COUNT] =
+    {     // received:  INVALID_HALFBIT, SHORT_HALFBIT     , LONG_HALFBIT
+                      { STATE_INVALID  , STATE_SHORT_INIT_1, STATE_LONG_INIT_1 } // STATE_INVALID
+                    , { STATE_INVALID  , STATE_SHORT_INIT_2, STATE_LONG_1      } // STATE_SHORT_INIT_1
+                    , { STATE_INVALID  , STATE_SHORT_INIT_1, STATE_LONG_1      } // STATE_SHORT_INIT_2
+                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_INIT_2 } // STATE_LONG_INIT_1 ,     
+                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_INIT_1 } // STATE_LONG_INIT_2 ,
+                    , { STATE_INVALID  , STATE_SHORT_2     , STATE_INVALID     } // STATE_SHORT_1       
+                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_1      } // STATE_SHORT_2     
+                    , { STATE_INVALID  , STATE_INVALID     , STATE_LONG_2      } // STATE_LONG_1      
+                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_1      } // STATE_LONG_2      
+    };
+
+    /**
+     * @brief Returns the event that is forwarded when state s is entered.
+     */
+    static constexpr eEvent event_of(uint8 s) noexcept
+    {
+      return (s == STATE_INVALID)                                ? EVENT_INVALID
+           : ((s == STATE_SHORT_INIT_2) || (s == STATE_SHORT_2)) ? EVENT_ONE
+           : ((s == STATE_LONG_INIT_2)  || (s == STATE_LONG_2))  ? EVENT_ZERO
+           :                                                       EVENT_NONE;
+    }
+
+    /// Transition table entry: bits 0-3 next state, bits 4-5 event
+    static constexpr uint8 kStateMask = 0x0FU;
+    static constexpr uint8 kEventShift = 4U;
+
+    /// Number of entries of the half bit table: one per microsecond in [0, kPartTimeLongMin].
+    /// Time differences above kPartTimeLongMin are either long (<= kPartTimeLongMax) or invalid.
+    static constexpr size_t kHalfBitTableSize = static_cast<size_t>(kPartTimeLongMin) + 1U;
+
+    static_assert(kPartTimeShortMin <= kPartTimeShortMax, "bit_extractor: short half bit range is empty");
+    static_assert(kPartTimeShortMax < kPartTimeLongMin, "bit_extractor: short and long half bits overlap");
+    static_assert(kPartTimeLongMin <= kPartTimeLongMax, "bit_extractor: long half bit range is empty");
+    static_assert(kPartTimeLongMin < 1024U, "bit_extractor: half bit table too large");
+
+    /**
+     * @brief Compile time generated lookup tables for transit().
+     *
+     * - halfbit_row: classifies a time difference [us] into a row of the transition table. The row
+     *   offset is stored pre-multiplied (INVALID_HALFBIT: 0, SHORT_HALFBIT: STATE_MAX_COUNT,
+     *   LONG_HALFBIT: 2 * STATE_MAX_COUNT).
+     * - transition: fused next state and event for [row offset + current state].
+     *
+     * The resolution is 1 us so that the thresholds of bit_extractor_constants are kept exactly.
+     */
+    struct transition_tables
+    {
+      uint8 halfbit_row[kHalfBitTableSize];
+      uint8 transition[HALFBIT_MAX_COUNT * STATE_MAX_COUNT];
+
+      constexpr transition_tables() : halfbit_row{}, transition{}
+      {
+        for (size_t dt = 0U; dt < kHalfBitTableSize; dt++)
+        {
+          halfbit_row[dt] = static_cast<uint8>(checkTick(static_cast<uint32_t>(dt)) * STATE_MAX_COUNT);
+        }
+        for (size_t hb = 0U; hb < HALFBIT_MAX_COUNT; hb++)
+        {
+          for (size_t s = 0U; s < STATE_MAX_COUNT; s++)
+          {
+            const uint8 next = kTransitionMap[s][hb];
+            transition[hb * STATE_MAX_COUNT + s] = static_cast<uint8>((event_of(next) << kEventShift) | next);
+          }
+        }
+      }
+    };
+
+    /// The lookup tables; located in flash on AVR
+    static const transition_tables ROM_CONST_VAR kTables;
+
+    /// Forwards an event to the packet extractor
+    using event_handler_type = void (*)(reference_type);
+    static void on_none(reference_type) noexcept {}
+    static void on_one(reference_type pex) { pex.one(); }
+    static void on_zero(reference_type pex) { pex.zero(); }
+    static void on_invalid(reference_type pex) { pex.invalid(); }
+
+    /// Event handlers; indexed with eEvent
+    static constexpr event_handler_type kEventHandlers[EVENT_MAX_COUNT] = { on_none, on_one, on_zero, on_invalid };
+
     /**
      * @brief For debugging: number of received interrupts per state (half bits) 
      */ 
@@ -168,24 +266,11 @@ namespace dcc
      * @param ulTime Time interval in microseconds since the last tick/interrupt.
      * @return eHalfBit Classified half bit type.
      */
-    static eHalfBit checkTick(uint32_t ulTime) noexcept
+    static constexpr eHalfBit checkTick(uint32_t ulTime) noexcept
     {
-      eHalfBit halfBitRcv;
-
-      if (isShortHalfBit(ulTime))
-      {
-        halfBitRcv = SHORT_HALFBIT;
-      }
-      else if (isLongHalfBit(ulTime))
-      {
-        halfBitRcv = LONG_HALFBIT;
-      }
-      else
-      {
-        halfBitRcv = INVALID_HALFBIT;
-      }
-
-      return halfBitRcv;
+      return isShortHalfBit(ulTime) ? SHORT_HALFBIT
+           : isLongHalfBit(ulTime)  ? LONG_HALFBIT
+           :                          INVALID_HALFBIT;
     }
 
     // ---------------------------------------------------
@@ -213,12 +298,20 @@ namespace dcc
       return (ulTime >= kPartTimeLongMin) && (ulTime <= kPartTimeLongMax);
     }
 
+    /**
+     * @brief Calculate the next state for a time difference and forward the bit event.
+     * @param s          Current state.
+     * @param ulTimeDiff Time difference in microseconds since the last tick/interrupt.
+     * @return Next state.
+     */
+    eState transit(eState s, uint32_t ulTimeDiff);
+
   public:
     /**
      * @brief Constructs a bit_extractor with a reference to the packet generator.
      * @param pex Reference to the packet generator that receives bit events.
      */
-    bit_extractor(reference_type pex) : state(STATE_INVALID), packet_extractor(pex)
+    bit_extractor(reference_type pex) : state(STATE_INVALID), prevState(STATE_INVALID), packet_extractor(pex)
     {
     #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
       call_counts.fill(0);
@@ -235,7 +328,48 @@ namespace dcc
      * This function processes the timing interval, updates the state machine, and forwards the detected bit event
      * to the bit stream or packet generator.
      */
-    void execute(uint32_t ulTimeDiff);
+    void execute(uint32_t ulTimeDiff)
+    {
+      prevState = state;
+      state = transit(state, ulTimeDiff);
+    }
+
+    /**
+     * @brief Execute the state machine with a buffer of time differences.
+     * 
+     * Gives the same bit events (and packets) as calling execute() for each element, but keeps
+     * the state in a local variable for the whole buffer. Intended for trace replay and bulk 
+     * decoding.
+     * 
+     * @param deltas Time differences in microseconds between subsequent edges.
+     * @param n      Number of elements in deltas.
+     */
+    void execute_many(const uint16_t *deltas, size_t n)
+    {
+      execute_many(deltas, deltas + n);
+    }
+
+    /**
+     * @brief Execute the state machine with a range of time differences [first, last).
+     * 
+     * @tparam InputIt Input iterator; the value type shall be convertible to uint32_t.
+     * @param first    Iterator to the first time difference in microseconds.
+     * @param last     Iterator behind the last time difference.
+     */
+    template<class InputIt>
+    void execute_many(InputIt first, InputIt last)
+    {
+      eState s = state;
+      eState s_prev = prevState;
+
+      for (; first != last; ++first)
+      {
+        s_prev = s;
+        s = transit(s, static_cast<uint32_t>(*first));
+      }
+      prevState = s_prev;
+      state = s;
+    }
 
     /**
      * @brief For debugging: return the number of calls for a given state (< STATE_MAX_COUNT).
@@ -246,57 +380,54 @@ namespace dcc
   };
 
   /**
-   * @brief Executes the bit_extractor state machine with a timing event.
+   * @brief Calculates the next state of the bit_extractor state machine for a timing event.
    * 
+   * @param s          Current state.
    * @param ulTimeDiff Time difference in microseconds since the last tick/interrupt (i.e., since the last half bit).
+   * @return Next state.
    *
-   * This function processes the given timing interval, updates the internal state machine according to the DCC protocol,
+   * This function processes the given timing interval, calculates the next state according to the DCC protocol,
    * and triggers the appropriate event (invalid, one, or zero) on the connected bit stream or packet generator.
    * The state transition logic ensures correct decoding of DCC bits from the incoming timing intervals.
+   *
+   * A half bit costs two table loads (half bit row, fused next state and event) and one indirect call.
    */
   template<class TBitExtractorConstants, class PacketGen>
-  void bit_extractor<TBitExtractorConstants, PacketGen>::execute(uint32_t ulTimeDiff)
+  inline typename bit_extractor<TBitExtractorConstants, PacketGen>::eState 
+    bit_extractor<TBitExtractorConstants, PacketGen>::transit(eState s, uint32_t ulTimeDiff)
   {
-    static const uint8 aTransitionMap[STATE_MAX_COUNT][3] =
-    {     // received:  INVALID_HALFBIT, SHORT_HALFBIT     , LONG_HALFBIT
-                      { STATE_INVALID  , STATE_SHORT_INIT_1, STATE_LONG_INIT_1 } // STATE_INVALID
-                    , { STATE_INVALID  , STATE_SHORT_INIT_2, STATE_LONG_1      } // STATE_SHORT_INIT_1
-                    , { STATE_INVALID  , STATE_SHORT_INIT_1, STATE_LONG_1      } // STATE_SHORT_INIT_2
-                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_INIT_2 } // STATE_LONG_INIT_1 ,     
-                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_INIT_1 } // STATE_LONG_INIT_2 ,
-                    , { STATE_INVALID  , STATE_SHORT_2     , STATE_INVALID     } // STATE_SHORT_1       
-                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_1      } // STATE_SHORT_2     
-                    , { STATE_INVALID  , STATE_INVALID     , STATE_LONG_2      } // STATE_LONG_1      
-                    , { STATE_INVALID  , STATE_SHORT_1     , STATE_LONG_1      } // STATE_LONG_2      
-    };
-
-    eHalfBit halfBitRcv;
-
-    prevState = state;
+    uint8 row;
+    uint8 entry;
 
-    halfBitRcv = checkTick(ulTimeDiff);
-    state = static_cast<eState>(aTransitionMap[state][static_cast<uint32_t>(halfBitRcv)]);
+    // classify the half bit: one table load below kPartTimeLongMin, one compare above
+    if (ulTimeDiff < kHalfBitTableSize)
+    {
+      row = ROM_READ_BYTE(&kTables.halfbit_row[ulTimeDiff]);
+    }
+    else
+    {
+      row = (ulTimeDiff <= kPartTimeLongMax) ? static_cast<uint8>(LONG_HALFBIT * STATE_MAX_COUNT) : static_cast<uint8>(0U);
+    }
+    entry = ROM_READ_BYTE(&kTables.transition[row + static_cast<uint8>(s)]);
+    s = static_cast<eState>(entry & kStateMask);
 
     #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
     // for debugging
-    call_counts.at(static_cast<typename tick_array_type::size_type>(state))++;
+    call_counts.at(static_cast<typename tick_array_type::size_type>(s))++;
     #endif
 
-    switch (state)
-    {
-    case STATE_INVALID:      { packet_extractor.invalid(); } break;
-    case STATE_SHORT_INIT_1: {                             } break;
-    case STATE_SHORT_INIT_2: { packet_extractor.one();     } break;
-    case STATE_LONG_INIT_1:  {                             } break;
-    case STATE_LONG_INIT_2:  { packet_extractor.zero();    } break;
-    case STATE_SHORT_1:      {                             } break;
-    case STATE_SHORT_2:      { packet_extractor.one();     } break;
-    case STATE_LONG_1:       {                             } break;
-    case STATE_LONG_2:       { packet_extractor.zero();    } break;
-    default:                 { } break;
-    }
+    kEventHandlers[entry >> kEventShift](packet_extractor);
+
+    return s;
   }
 
+  // ---------------------------------------------------
+  /// Lookup tables of transit(), generated at compile time
+  // ---------------------------------------------------
+  template<class TBitExtractorConstants, class PacketGen>
+  const typename bit_extractor<TBitExtractorConstants, PacketGen>::transition_tables ROM_CONST_VAR
+    bit_extractor<TBitExtractorConstants, PacketGen>::kTables;
+
   // ---------------------------------------------------
   /// For debugging: return number of calls for a state (< STATE_MAX_COUNT)
   // ---------------------------------------------------
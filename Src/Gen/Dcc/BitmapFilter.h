@@ -0,0 +1,428 @@
+/**
+ * @file BitmapFilter.h
+ * @author Ralf Sondershaus
+ *
+ * @brief DCC address filters with bitmaps
+ *
+ * Declares classes dcc::accessory_bitmap_filter and dcc::loco_bitmap_filter that let packets
+ * pass for a set of addresses. Testing an address costs the same for any number of addresses
+ * and address ranges.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_BITMAPFILTER_H
+#define DCC_BITMAPFILTER_H
+
+#include <Std_Types.h>
+#include <Dcc/Filter.h>
+#include <Dcc/Packet.h>
+#include <Util/bitset.h>
+
+namespace dcc
+{
+    // ---------------------------------------------------------------------
+    /// This filter lets accessory packets pass for a set of addresses.
+    ///
+    /// The addresses are stored in a bitmap with one bit per address 0 - 2048 (basic accessory
+    /// output addresses 1 - 2048, decoder addresses 0 - 511, extended accessory addresses 0 - 2047).
+    /// Several non-contiguous address ranges can be set at no extra cost.
+    ///
+    /// The first byte of a packet is checked first: it carries the lower 6 bits of the decoder
+    /// address, so a second (small) bitmap over these 6 bits rejects most packets for other
+    /// decoders before the address is calculated. The address is then calculated from the
+    /// first two bytes. The packet type (checksum, length) is only decoded for packets that
+    /// pass the bitmaps.
+    ///
+    /// Service mode instructions (0111CCVV, 4 bytes) have the same format as multi function
+    /// packets for addresses 112 - 127 on the main track. If service mode is enabled (see
+    /// enable_service_mode()), the filter decides on the unfiltered packet stream whether the
+    /// decoder is in service mode [S-9.2.3]: kNrServiceModeResets reset packets in a row enter
+    /// service mode, any packet other than a reset packet or a service mode instruction (idle
+    /// packets, packets for other addresses) leaves it. Service mode instructions pass in
+    /// service mode only.
+    ///
+    /// The class is final so that calls of do_filter() on an object of this class are resolved
+    /// at compile time (see CFG_DCC_DECODER_ADDRESS_FILTER).
+    ///
+    /// @note Can be called from an ISR context. Modify the addresses from the main loop only.
+    ///
+    /// @tparam Packet Type of Dcc Packet such as dcc::Packet<6>
+    // ---------------------------------------------------------------------
+    template <class Packet>
+    class accessory_bitmap_filter final : public filter<Packet>
+    {
+    public:
+        /// The base class
+        using parent_type = filter<Packet>;
+        using packet_type = typename parent_type::packet_type;
+        using address_type = typename Packet::address_type;
+
+        /// Number of addresses (0 - 2048)
+        static constexpr address_type kNrAddresses = 2049U;
+        /// Number of reset packets in a row that enter service mode [S-9.2.3]
+        static constexpr uint8 kNrServiceModeResets = 3U;
+
+    protected:
+        /// One bit per address
+        util::bitset<uint8, kNrAddresses> addresses;
+        /// One bit per lower 6 bits of the first byte (10AAAAAA)
+        util::bitset<uint8, 64U> primary_addresses;
+        /**
+         * @brief CV29 value for the decoder. Used for address calculation.
+         */
+        uint8 cv29;
+        /**
+         * @brief True if reset packets and service mode instructions can pass (see enable_service_mode()).
+         */
+        bool service_mode_enabled;
+        /**
+         * @brief Number of reset packets in a row (saturates at kNrServiceModeResets). Service mode
+         * instructions keep the value, any other packet clears it. Written in the ISR context.
+         */
+        mutable uint8 nr_resets;
+
+        /// Returns true if byte0 is the first byte of a reset packet or a service mode instruction
+        static bool is_service_mode_byte0(uint8 byte0) noexcept { return (byte0 == 0U) || ((byte0 & 0xF0U) == 0x70U); }
+
+        /// Set the bit of the first byte(s) that can carry address addr
+        void set_primary(address_type addr) noexcept
+        {
+            // extended accessory and basic accessory with decoder address method
+            primary_addresses.set(addr & 0x3FU);
+            if (cv29 & cfg::kBitMask_Cv29_OutputAddressMethod)
+            {
+                // basic accessory with output address method: (decoder address << 2 | pair) - 3
+                primary_addresses.set(((addr + 3U) >> 2U) & 0x3FU);
+            }
+        }
+
+        /// Recalculate the bitmap of the first bytes from the addresses
+        void update_primary() noexcept
+        {
+            primary_addresses.reset();
+            for (address_type addr = 0U; addr < kNrAddresses; addr++)
+            {
+                if (addresses.test(addr))
+                {
+                    set_primary(addr);
+                }
+            }
+        }
+
+    public:
+        /// The default constructor defines a filter that does not let any packet pass.
+        accessory_bitmap_filter() : cv29(0U), service_mode_enabled(false), nr_resets(0U) { clear(); }
+
+        /// Define a filter that does not let any packet pass.
+        void clear() noexcept
+        {
+            addresses.reset();
+            primary_addresses.reset();
+        }
+
+        /**
+         * @brief Set the cv29. Used for address calculation.
+         *
+         * @param cv29_value The value of CV29 from the decoder's configuration.
+         */
+        void set_cv29(uint8 cv29_value) noexcept
+        {
+            if (cv29_value != cv29)
+            {
+                cv29 = cv29_value;
+                update_primary();
+            }
+        }
+
+        /**
+         * @brief Get the cv29
+         *
+         * @return uint8 The value of CV29
+         */
+        uint8 get_cv29() const noexcept { return cv29; }
+
+        /**
+         * @brief Let reset packets pass, and service mode instructions (0111CCVV, see 
+         * packet::is_service_mode()) in service mode, so that the decoder can be programmed on
+         * a programming track (see dcc::cv_programming). Service mode instructions carry no address.
+         *
+         * @param enable true: let the packets pass
+         */
+        void enable_service_mode(bool enable) noexcept
+        {
+            service_mode_enabled = enable;
+            nr_resets = 0U;
+        }
+
+        /// Returns true if reset packets and service mode instructions can pass
+        bool is_service_mode_enabled() const noexcept { return service_mode_enabled; }
+
+        /// Returns true in service mode: service mode instructions pass
+        bool is_service_mode() const noexcept { return service_mode_enabled && (nr_resets >= kNrServiceModeResets); }
+
+        /**
+         * @brief Let packets for address addr pass (value is true) or not pass (value is false).
+         * Addresses out of range are ignored.
+         */
+        void set(address_type addr, bool value = true) noexcept
+        {
+            if (addr < kNrAddresses)
+            {
+                addresses.set(addr, value);
+                if (value)
+                {
+                    set_primary(addr);
+                }
+                else
+                {
+                    update_primary();
+                }
+            }
+        }
+
+        /// Let packets pass for the address range addr_lo <= address <= addr_hi
+        void set_range(address_type addr_lo, address_type addr_hi) noexcept
+        {
+            for (uint32 addr = addr_lo; (addr <= addr_hi) && (addr < kNrAddresses); addr++)
+            {
+                set(static_cast<address_type>(addr));
+            }
+        }
+
+        /// Returns true if packets for address addr pass
+        bool test(address_type addr) const noexcept { return (addr < kNrAddresses) && addresses.test(addr); }
+
+        /// Returns false if no packet with first byte byte0 passes the filter (see decoder::accept_first_byte()).
+        /// Leaves service mode if byte0 is not the first byte of a reset packet or a service mode instruction.
+        bool may_pass(uint8 byte0) const noexcept
+        {
+            if (!is_service_mode_byte0(byte0))
+            {
+                nr_resets = 0U;
+                return ((byte0 & 0xC0U) == 0x80U) && primary_addresses.test(byte0 & 0x3FU);
+            }
+            return service_mode_enabled && ((byte0 == 0U) || (nr_resets >= kNrServiceModeResets));
+        }
+
+        /// Returns true if the packet passes the filter. Returns false if the packet does not pass the filter.
+        bool do_filter(packet_type &pkt) const noexcept override
+        {
+            bool does_pass = false;
+            const uint8 byte0 = pkt.refByte(0);
+            // accessory packets: 10AAAAAA
+            if ((pkt.getNrBytes() > 2U) && ((byte0 & 0xC0U) == 0x80U) && primary_addresses.test(byte0 & 0x3FU))
+            {
+                const uint8 byte1 = pkt.refByte(1);
+                const address_type addr = util::bits::test(byte1, 7U) ?
+                                            packet_type::basic_accessory_address(byte0, byte1, cv29) :
+                                            packet_type::extended_accessory_address(byte0, byte1);
+                if (test(addr))
+                {
+                    // checks checksum and length
+                    does_pass = ((pkt.get_type() == packet_type::packet_type::BasicAccessory) ||
+                                 (pkt.get_type() == packet_type::packet_type::ExtendedAccessory));
+                }
+            }
+            if (!is_service_mode_byte0(byte0))
+            {
+                nr_resets = 0U;
+            }
+            else if (pkt.is_reset())
+            {
+                // reset packets: 00000000
+                if (nr_resets < kNrServiceModeResets)
+                {
+                    nr_resets++;
+                }
+                does_pass = service_mode_enabled;
+            }
+            else if (pkt.is_service_mode())
+            {
+                // service mode instructions 0111CCVV, or multi function packets for addresses
+                // 112 - 127 on the main track
+                does_pass = service_mode_enabled && (nr_resets >= kNrServiceModeResets);
+            }
+            else
+            {
+                // other broadcast or multi function packets leave service mode
+                nr_resets = 0U;
+            }
+            return does_pass;
+        }
+    };
+
+    // ---------------------------------------------------------------------
+    /// This filter lets multi function (locomotive) packets pass for a set of addresses.
+    ///
+    /// Addresses 0 - 127 are 7 bit addresses (0 is the broadcast address). They are stored in a
+    /// bitmap with one bit per address. Addresses 128 - 10239 are 14 bit addresses. They are
+    /// stored in pages of 256 addresses; a page holds the addresses with the same first byte
+    /// (11AAAAAA). A table with one entry per first byte points to the page. Only NrPages pages
+    /// are stored, so a set of addresses that spans many first bytes does not fit.
+    ///
+    /// The class is final so that calls of do_filter() on an object of this class are resolved
+    /// at compile time (see CFG_DCC_DECODER_ADDRESS_FILTER).
+    ///
+    /// @note Can be called from an ISR context. Modify the addresses from the main loop only.
+    ///
+    /// @tparam Packet   Type of Dcc Packet such as dcc::Packet<6>
+    /// @tparam NrPages  Number of pages with 256 addresses each (32 bytes each)
+    // ---------------------------------------------------------------------
+    template <class Packet, int NrPages = 2>
+    class loco_bitmap_filter final : public filter<Packet>
+    {
+    public:
+        /// The base class
+        using parent_type = filter<Packet>;
+        using packet_type = typename parent_type::packet_type;
+        using address_type = typename Packet::address_type;
+
+        static_assert((NrPages > 0) && (NrPages < 255), "loco_bitmap_filter: NrPages must be in [1, 254]");
+
+        /// Number of 7 bit addresses (0 - 127)
+        static constexpr address_type kNrShortAddresses = 128U;
+        /// Number of addresses (0 - 10239)
+        static constexpr address_type kNrAddresses = 10240U;
+        /// Number of first bytes of 14 bit addresses (192 - 231)
+        static constexpr uint8 kNrPageIndices = packet_type::kPrimaryAddressMultiFunction14_Hi - packet_type::kPrimaryAddressMultiFunction14_Lo + 1U;
+        /// Page index if no page is used
+        static constexpr uint8 kNoPage = 0xFFU;
+
+    protected:
+        /// One bit per 7 bit address
+        util::bitset<uint8, kNrShortAddresses> short_addresses;
+        /// Pages of 14 bit addresses, indexed by the second byte
+        util::bitset<uint8, 256U> pages[NrPages];
+        /// Page index per first byte (minus kPrimaryAddressMultiFunction14_Lo)
+        uint8 page_index[kNrPageIndices];
+        /// Number of used pages
+        uint8 nr_used_pages;
+
+    public:
+        /// The default constructor defines a filter that does not let any packet pass.
+        loco_bitmap_filter() { clear(); }
+
+        /// Define a filter that does not let any packet pass.
+        void clear() noexcept
+        {
+            short_addresses.reset();
+            for (int i = 0; i < NrPages; i++)
+            {
+                pages[i].reset();
+            }
+            for (uint8 i = 0U; i < kNrPageIndices; i++)
+            {
+                page_index[i] = kNoPage;
+            }
+            nr_used_pages = 0U;
+        }
+
+        /**
+         * @brief Let packets for address addr pass (value is true) or not pass (value is false).
+         *
+         * @return false if the address is out of range or if no page is left for the address
+         */
+        bool set(address_type addr, bool value = true) noexcept
+        {
+            bool ret = true;
+            if (addr < kNrShortAddresses)
+            {
+                short_addresses.set(addr, value);
+            }
+            else if (addr < kNrAddresses)
+            {
+                const uint8 idx = static_cast<uint8>(addr >> 8U);
+                if (page_index[idx] == kNoPage)
+                {
+                    if (!value)
+                    {
+                        // nothing to do
+                    }
+                    else if (nr_used_pages < NrPages)
+                    {
+                        // the page is cleared
+                        page_index[idx] = nr_used_pages;
+                        nr_used_pages++;
+                    }
+                    else
+                    {
+                        ret = false;
+                    }
+                }
+                if (page_index[idx] != kNoPage)
+                {
+                    pages[page_index[idx]].set(addr & 0xFFU, value);
+                }
+            }
+            else
+            {
+                ret = false;
+            }
+            return ret;
+        }
+
+        /// Returns true if packets for address addr pass
+        bool test(address_type addr) const noexcept
+        {
+            bool ret = false;
+            if (addr < kNrShortAddresses)
+            {
+                ret = short_addresses.test(addr);
+            }
+            else if (addr < kNrAddresses)
+            {
+                const uint8 page = page_index[addr >> 8U];
+                ret = (page != kNoPage) && pages[page].test(addr & 0xFFU);
+            }
+            return ret;
+        }
+
+        /// Returns false if no packet with first byte byte0 passes the filter (see decoder::accept_first_byte())
+        bool may_pass(uint8 byte0) const noexcept
+        {
+            bool ret = false;
+            if (byte0 <= packet_type::kPrimaryAddressMultiFunction7_Hi)
+            {
+                ret = short_addresses.test(byte0);
+            }
+            else if ((byte0 >= packet_type::kPrimaryAddressMultiFunction14_Lo) && (byte0 <= packet_type::kPrimaryAddressMultiFunction14_Hi))
+            {
+                ret = (page_index[byte0 - packet_type::kPrimaryAddressMultiFunction14_Lo] != kNoPage);
+            }
+            return ret;
+        }
+
+        /// Returns true if the packet passes the filter. Returns false if the packet does not pass the filter.
+        bool do_filter(packet_type &pkt) const noexcept override
+        {
+            bool does_pass = false;
+            const uint8 byte0 = pkt.refByte(0);
+            if (pkt.getNrBytes() > 2U)
+            {
+                if (byte0 <= packet_type::kPrimaryAddressMultiFunction7_Hi)
+                {
+                    does_pass = short_addresses.test(byte0);
+                }
+                else if ((byte0 >= packet_type::kPrimaryAddressMultiFunction14_Lo) && (byte0 <= packet_type::kPrimaryAddressMultiFunction14_Hi))
+                {
+                    const uint8 page = page_index[byte0 - packet_type::kPrimaryAddressMultiFunction14_Lo];
+                    does_pass = (page != kNoPage) && pages[page].test(pkt.refByte(1));
+                }
+                if (does_pass)
+                {
+                    // checks checksum and length
+                    const typename packet_type::packet_type type = pkt.get_type();
+                    does_pass = ((type == packet_type::packet_type::MultiFunction7) ||
+                                 (type == packet_type::packet_type::MultiFunction14) ||
+                                 (type == packet_type::packet_type::MultiFunctionBroadcast));
+                }
+            }
+            return does_pass;
+        }
+    };
+} // namespace dcc
+
+#endif // DCC_BITMAPFILTER_H
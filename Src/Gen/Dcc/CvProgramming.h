@@ -0,0 +1,187 @@
+/**
+ * @file CvProgramming.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::cv_programming that turns decoded CV access instructions
+ * (operations mode and service mode) into CV write and verify requests
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_CVPROGRAMMING_H
+#define DCC_CVPROGRAMMING_H
+
+#include <Std_Types.h>
+#include <Hal/Timer.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// State machine for CV access instructions of decoded commands (see dcc::decoded_command).
+  ///
+  /// - A CV access instruction is executed when two identical instructions were received in a
+  ///   row [S-9.2.1]. Further repetitions are not executed again, so a command station that
+  ///   repeats a write does not write the CV multiple times. Command stations repeat CV access
+  ///   packets, so the repeat filter shall let them pass (see dcc::repeat_filter).
+  /// - Service mode [S-9.2.3]: a reset packet enters service mode. Service mode instructions
+  ///   (0111CCVV) are executed in service mode only; service mode ends with any other packet or
+  ///   if no reset or service mode packet is received for ServiceModeTimeout ms. The timeout is
+  ///   measured when the main loop processes the commands, so it includes the cycle time of the
+  ///   main loop.
+  ///   Only packets that passed the address filter are processed here, so the idle packets and
+  ///   packets for other addresses that end service mode are not seen. The address filter
+  ///   decides on the unfiltered packet stream whether service mode instructions pass (see
+  ///   dcc::accessory_bitmap_filter::enable_service_mode()).
+  ///
+  /// The caller executes the request (see request_type::apply() and request_type::verify()).
+  ///
+  /// @tparam Command            Type of decoded command such as dcc::decoded_command<dcc::packet<6>>
+  /// @tparam ServiceModeTimeout [ms] Service mode ends if no reset or service mode packet is received
+  // ---------------------------------------------------------------------
+  template<class Command, uint16 ServiceModeTimeout = 50U>
+  class cv_programming
+  {
+  public:
+    using command_type = Command;
+    using packet_type = typename command_type::packet_type;
+    using address_type = typename command_type::address_type;
+
+    /// [ms] Service mode ends if no reset or service mode packet is received
+    static constexpr uint16 kServiceModeTimeout = ServiceModeTimeout;
+
+    /// A CV access to be executed by the caller
+    struct request_type
+    {
+      /// CV number [1-1024]
+      uint16 cv;
+      /// packet_type::kCvVerifyByte, kCvBitManipulation or kCvWriteByte
+      uint8 operation;
+      /// DDDDDDDD (bit manipulation: 111KDBBB)
+      uint8 data;
+      /// True if the request was received in service mode (acknowledge with a current pulse)
+      bool service_mode;
+
+      /// Returns true if the request writes the CV (write byte, write bit)
+      bool is_write() const noexcept
+      {
+        return (operation == packet_type::kCvWriteByte) || ((operation == packet_type::kCvBitManipulation) && ((data & 0x10U) != 0U));
+      }
+
+      /// Write: returns the new value of the CV from its current value
+      uint8 apply(uint8 cv_value) const noexcept
+      {
+        if (operation == packet_type::kCvWriteByte)
+        {
+          return data;
+        }
+        // 111KDBBB: set bit BBB to D
+        const uint8 mask = static_cast<uint8>(1U << (data & 0x07U));
+        return ((data & 0x08U) != 0U) ? static_cast<uint8>(cv_value | mask) : static_cast<uint8>(cv_value & ~mask);
+      }
+
+      /// Verify: returns true if the current value of the CV matches (acknowledge)
+      bool verify(uint8 cv_value) const noexcept
+      {
+        if (operation == packet_type::kCvVerifyByte)
+        {
+          return cv_value == data;
+        }
+        // 111KDBBB: bit BBB equals D
+        return (((cv_value >> (data & 0x07U)) & 1U) != 0U) == ((data & 0x08U) != 0U);
+      }
+    };
+
+  protected:
+    /// Last CV access instruction: program and value of the decoded command
+    uint16 last_program;
+    uint8 last_value;
+    address_type last_address;
+    /// True if the last CV access instruction has been executed
+    bool last_executed;
+    /// True in service mode
+    bool service_mode;
+    /// [ms] Time of the last reset or service mode packet
+    uint16 service_mode_ms;
+
+  public:
+    /// Construct in operations mode
+    cv_programming() noexcept { reset(); }
+
+    /// Forget the last instruction and leave service mode
+    void reset() noexcept
+    {
+      last_program = 0U;
+      last_value = 0U;
+      last_address = packet_type::kInvalidAddress;
+      last_executed = false;
+      service_mode = false;
+      service_mode_ms = 0U;
+    }
+
+    /// Returns true in service mode
+    bool is_service_mode() const noexcept { return service_mode; }
+
+    /**
+     * @brief Process a decoded command that passed the address filter.
+     *
+     * @param cmd The decoded command
+     * @param req The request if the function returns true
+     * @return true if a CV access shall be executed
+     */
+    bool execute(const command_type& cmd, request_type& req) noexcept
+    {
+      const uint16 now = static_cast<uint16>(hal::millis());
+      if (service_mode && (static_cast<uint16>(now - service_mode_ms) >= kServiceModeTimeout))
+      {
+        service_mode = false;
+      }
+      if (cmd.is_reset())
+      {
+        service_mode = true;
+        service_mode_ms = now;
+        last_program = 0U;
+        return false;
+      }
+      if (!cmd.is_cv_access())
+      {
+        // any other packet ends service mode
+        service_mode = false;
+        return false;
+      }
+      if (cmd.is_service_mode())
+      {
+        if (!service_mode)
+        {
+          // a multi function packet for addresses 112 - 127
+          return false;
+        }
+        service_mode_ms = now;
+      }
+      if ((cmd.program != last_program) || (cmd.value != last_value) || (cmd.get_address() != last_address))
+      {
+        // first of two identical instructions
+        last_program = cmd.program;
+        last_value = cmd.value;
+        last_address = cmd.get_address();
+        last_executed = false;
+        return false;
+      }
+      if (last_executed)
+      {
+        // repetition of an executed instruction
+        return false;
+      }
+      last_executed = true;
+      req.cv = cmd.cv_get_number();
+      req.operation = cmd.cv_get_operation();
+      req.data = cmd.cv_get_data();
+      req.service_mode = cmd.is_service_mode();
+      return true;
+    }
+  };
+} // namespace dcc
+
+#endif // DCC_CVPROGRAMMING_H
@@ -0,0 +1,163 @@
+/**
+ * @file DecodedCommand.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::decoded_command, a compact record of a decoded DCC packet
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_DECODEDCOMMAND_H
+#define DCC_DECODEDCOMMAND_H
+
+#include <Std_Types.h>
+#include <Dcc/DecoderCfg.h>
+#include <Dcc/Packet.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// Compact record of a decoded DCC packet: type, address, value and checksum status.
+  ///
+  /// The packet is decoded once when it is complete (see assign()), so consumers do not parse
+  /// the bytes again. The value depends on the type:
+  /// - BasicAccessory: the lower four bits of the second byte (1AAADAAR, see ba_get_output_direction())
+  /// - ExtendedAccessory: the aspect (see ea_get_aspect())
+  /// - MultiFunction7, MultiFunction14, MultiFunctionBroadcast: the first instruction byte
+  /// - CV access instructions (see is_cv_access()): the data byte DDDDDDDD
+  /// - other types: 0
+  ///
+  /// CV access instructions (operations mode programming of accessory decoders, service mode
+  /// direct mode) and reset packets are marked in program (see packet::is_cv_access()).
+  ///
+  /// @tparam Packet Type of DCC packet such as dcc::packet<6>
+  // ---------------------------------------------------------------------
+  template<class Packet>
+  class decoded_command
+  {
+  public:
+    using packet_type = Packet;
+    using address_type = typename packet_type::address_type;
+    using type_type = typename packet_type::packet_type;
+
+    /// The decoded address (see packet::get_address()); packet_type::kInvalidAddress if the type has no address
+    address_type address;
+    /// The packet type
+    type_type type;
+    /// Depends on the type (see class description)
+    uint8 value;
+    /// True if the checksum is correct
+    bool checksum_ok;
+    /// CV access: bits 0-9 CV number - 1, bits 10-11 CC (0 if no CV access), bit 14 service mode
+    /// (first byte 0111CCVV), bit 15 reset packet
+    uint16 program;
+    #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    /// [us] Time stamp of the packet (see packet::get_timestamp())
+    uint32 timestamp_us;
+    #endif
+
+    /// Construct an invalid command
+    decoded_command() noexcept
+      : address(packet_type::kInvalidAddress), type(type_type::Init), value(0U), checksum_ok(false), program(0U)
+    #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+      , timestamp_us(0U)
+    #endif
+    {}
+
+    /**
+     * @brief Decode a packet into this command.
+     *
+     * @param pkt  The packet. Not const because the packet caches its type and address.
+     * @param cv29 The value of CV29 (address method of accessory decoders)
+     */
+    void assign(packet_type& pkt, uint8 cv29) noexcept
+    {
+      type = pkt.get_type();
+      address = pkt.get_address(cv29);
+      checksum_ok = pkt.is_checksum_ok();
+      switch (type)
+      {
+        case type_type::BasicAccessory:
+          value = static_cast<uint8>(pkt.refByte(1) & 0x0FU);
+          break;
+        case type_type::ExtendedAccessory:
+          value = pkt.ea_get_aspect();
+          break;
+        case type_type::MultiFunction7:
+        case type_type::MultiFunctionBroadcast:
+          value = pkt.refByte(1);
+          break;
+        case type_type::MultiFunction14:
+          value = pkt.refByte(2);
+          break;
+        default:
+          value = 0U;
+          break;
+      }
+      program = 0U;
+      if (pkt.is_cv_access())
+      {
+        // 1110CCVV / 0111CCVV VVVVVVVV DDDDDDDD
+        const uint8 i = pkt.get_cv_access_index();
+        program = static_cast<uint16>((static_cast<uint16>(pkt.refByte(i) & 0x0FU) << 8U) | pkt.refByte(i + 1U));
+        if (pkt.is_service_mode())
+        {
+          program |= kProgramServiceMode;
+        }
+        value = pkt.refByte(i + 2U);
+      }
+      else if (pkt.is_reset())
+      {
+        program = kProgramReset;
+      }
+      #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+      timestamp_us = pkt.get_timestamp();
+      #endif
+    }
+
+    /// Returns the packet type
+    type_type get_type() const noexcept { return type; }
+    /// Returns the decoded address
+    address_type get_address() const noexcept { return address; }
+    /// Returns true if the checksum is correct
+    bool is_checksum_ok() const noexcept { return checksum_ok; }
+    #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    /// Returns the time stamp [us], see CFG_DCC_DECODER_TIMESTAMP
+    uint32 get_timestamp() const noexcept { return timestamp_us; }
+    #endif
+
+    /// Basic Accessory: returns the output direction R [0 or 1] (see packet::ba_get_output_direction())
+    uint8 ba_get_output_direction() const noexcept { return static_cast<uint8>(value & 0b00000001U); }
+    /// Basic Accessory: returns the output power D [0 or 1] (see packet::ba_get_output_power())
+    uint8 ba_get_output_power() const noexcept { return static_cast<uint8>((value & 0b00001000U) >> 3U); }
+    /// Basic Accessory: returns the output pair [0-3] (see packet::ba_get_output_pair())
+    uint8 ba_get_output_pair() const noexcept { return static_cast<uint8>((value & 0b00000110U) >> 1U); }
+    /// Extended Accessory: returns the aspect [0-31] (see packet::ea_get_aspect())
+    uint8 ea_get_aspect() const noexcept { return value; }
+
+    /// Bits of program
+    static constexpr uint16 kProgramCvMask = 0x03FFU;
+    static constexpr uint16 kProgramOperationMask = 0x0C00U;
+    static constexpr uint8 kProgramOperationShift = 10U;
+    static constexpr uint16 kProgramServiceMode = 0x4000U;
+    static constexpr uint16 kProgramReset = 0x8000U;
+
+    /// Returns true if the command is a CV access instruction (CC != 00)
+    bool is_cv_access() const noexcept { return (program & kProgramOperationMask) != 0U; }
+    /// Returns true if the CV access instruction is a service mode instruction (0111CCVV); only valid in service mode
+    bool is_service_mode() const noexcept { return (program & kProgramServiceMode) != 0U; }
+    /// Returns true if the command is a digital decoder reset packet
+    bool is_reset() const noexcept { return (program & kProgramReset) != 0U; }
+    /// CV access: returns the CV number [1-1024]
+    uint16 cv_get_number() const noexcept { return static_cast<uint16>((program & kProgramCvMask) + 1U); }
+    /// CV access: returns CC (packet_type::kCvVerifyByte, kCvBitManipulation, kCvWriteByte)
+    uint8 cv_get_operation() const noexcept { return static_cast<uint8>((program & kProgramOperationMask) >> kProgramOperationShift); }
+    /// CV access: returns the data byte DDDDDDDD
+    uint8 cv_get_data() const noexcept { return value; }
+  };
+} // namespace dcc
+
+#endif // DCC_DECODEDCOMMAND_H
@@ -13,7 +13,7 @@
  */
 
 #include <Std_Types.h>
-#include <OS_Type.h> // SuspendAllInterrupts, ResumeAllInterrupts, ISR macros
+#include <OS_Type.h> // ISR macros
 #include <Dcc/BitExtractor.h>
 #include <Dcc/Decoder.h>
 #include <Util/Algorithm.h> // max
@@ -22,16 +22,11 @@
 
 namespace dcc
 {
-#if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
-    uint16 unBitStreamMaxSize = 0;
-    /// For debugging: the number of interrupt ISR_Dcc calls (can overflow)
-    uint32 ISR_dcc_count;
-#endif
-
     // ---------------------------------------------------
     /// This function is called by the ISR when a falling or rising edge has triggered the interrupt.
     ///
-    /// Pushes a 0, 1, or invalid into the underlying bit stream.
+    /// Pushes a 0, 1, or invalid into the underlying bit stream (ISR mode) or stores the time delta
+    /// in the edge ring (deferred mode, see decoder::process_edges()).
     ///
     /// @note Average run time 34 usec @ATmega2560 @16 MHz with gcc -O3
     ///       Size 1342 bytes with gcc -O3
@@ -40,16 +35,14 @@ namespace dcc
     /// @note Average run time 52 usec @ATmega2560 @16 MHz with gcc -Os
     ///       Size 370 bytes with gcc -Os
     // ---------------------------------------------------
-    void ISR_Dcc(void) noexcept
+    void decoder::on_edge() noexcept
     {
-        static bool bFirstCall = true;
-        static unsigned long prev = 0;
         const unsigned long now = hal::micros();
 
-        if (bFirstCall)
+        if (first_edge)
         {
             // first call
-            bFirstCall = false;
+            first_edge = false;
         }
         else
         {
@@ -58,44 +51,40 @@ namespace dcc
             // This is the time delta in microseconds
             // Note: ULONG_MAX is the maximum value for an unsigned long, which is 4294967295 on most platforms.
             // This calculation handles the wrap-around case correctly.
-            const unsigned long dt = (now >= prev) ? (now - prev) : (now + (platform::numeric_limits<unsigned long>::max_() - prev) + 1UL);
-            // Execute the state machine with the time delta.
+            const unsigned long dt = (now >= prev_edge_us) ? (now - prev_edge_us) : (now + (platform::numeric_limits<unsigned long>::max_() - prev_edge_us) + 1UL);
+            // Execute the state machine with the time delta (or store the time delta).
             // Calls packet_received when a full packet is received.
-            decoder::get_instance().get_bit_extractor().execute(dt);
+            edge_received(dt);
         }
-        prev = now;
+        prev_edge_us = now;
 
         #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
         // for debugging
-        ISR_dcc_count++;
+        interrupt_count++;
         #endif
     }
 
     // ---------------------------------------------------
     /// Initialize
     // ---------------------------------------------------
-    void decoder::init(uint8 pin)
+    bool decoder::init(uint8 pin)
     {
-        hal::attachInterrupt(digitalPinToInterrupt(static_cast<int>(pin)), ISR_Dcc, CHANGE);
+        return hal::attachInterrupt(static_cast<uint8>(digitalPinToInterrupt(static_cast<int>(pin))), &decoder::isr, this, CHANGE);
     }
 
     /**
-     * @brief Switch the double buffer for packet reception.
+     * @brief Decode all edges that the ISR has stored in the edge ring.
      */
-    void decoder::fetch()
-    {
-        SuspendAllInterrupts();
-        packet_double_buffer.toggle();
-        ResumeAllInterrupts();
-    }
-
-#if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
-    /// for debugging: number of interrupt (ISR) calls
-    uint32 decoder::get_interrupt_count() const
+    void decoder::process_edges()
     {
-        return ISR_dcc_count;
+        #if CFG_DCC_DECODER_MODE == OPT_DCC_DECODER_MODE_DEFERRED
+        uint16 dt;
+        while (edge_ring.pop(dt))
+        {
+            decode_edge(dt);
+        }
+        #endif
     }
-#endif
 
 } // namespace dcc
 
@@ -16,9 +16,14 @@
 #include <Std_Types.h>
 #include <Dcc/DecoderCfg.h>
 #include <Dcc/BitExtractor.h>
+#include <Dcc/GlitchFilter.h>
+#include <Dcc/TimingCalibration.h>
+#include <Dcc/HalfBitHistogram.h>
 #include <Dcc/PacketExtractor.h>
 #include <Dcc/Filter.h>
-#include <Util/Fix_Queue.h>
+#include <Dcc/DecodedCommand.h>
+#include <Dcc/BitmapFilter.h>
+#include <Util/Spsc_Queue.h>
 #include <Util/Ptr.h>
 
 namespace dcc
@@ -27,85 +32,99 @@ namespace dcc
      * @class decoder
      * @brief Main class for converting DCC signals into packets and providing FIFO access.
      *
+     * The decoder is the handler of its packet extractor. It is bound at compile time (template 
+     * parameter of packet_extractor), so packet_received() and get_packet_slot() are not virtual
+     * and the ISR path from the bit extractor to the packet FIFO is inlined.
+     *
+     * Each decoder owns its extractors, FIFO and filters, so a board can decode multiple DCC 
+     * inputs (e.g. two booster districts) with one decoder per input pin (see init()). The ISR
+     * reaches its decoder via a context pointer (see hal::attachInterrupt()).
      */
-    class decoder : public packet_extractor<>::handler_ifc
+    class decoder
     {
     public:
-        using bit_extractor_type = bit_extractor<>;
-        using packet_extractor_type = packet_extractor<>;
+        using packet_extractor_type = packet_extractor<10, decoder, CFG_DCC_DECODER_EARLY_REJECT == OPT_DCC_DECODER_EARLY_REJECT_ON>;
+        using bit_extractor_type = bit_extractor<bit_extractor_constants<>, packet_extractor_type>;
+        using timing_calibration_type = timing_calibration<bit_extractor_type>;
+        #if CFG_DCC_DECODER_CALIBRATION == OPT_DCC_DECODER_CALIBRATION_ON
+        using glitch_filter_type = glitch_filter<timing_calibration_type>;
+        #else
+        using glitch_filter_type = glitch_filter<bit_extractor_type>;
+        #endif
+        using halfbit_histogram_type = halfbit_histogram<>;
         using packet_type = packet_extractor_type::packet_type;
-        using handler_ifc = packet_extractor_type::handler_ifc;
+        using command_type = decoded_command<packet_type>;
+        #if CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON
+        using value_type = command_type;
+        #else
+        using value_type = packet_type;
+        #endif
         using filter_type = dcc::filter<packet_type>;
         using filter_pointer_type = util::ptr<const filter_type>;
-
-        static const size_t kMaxNrPackets = CFG_DCC_DECODER_FIFO_SIZE; ///< Maximal number of packets stored in FIFO
+        #if CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_ACCESSORY
+        using address_filter_type = dcc::accessory_bitmap_filter<packet_type>;
+        #elif CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_LOCO
+        using address_filter_type = dcc::loco_bitmap_filter<packet_type>;
+        #endif
+        /// Function that is called when a packet passed the filters (see set_packet_notification())
+        using notification_func_pointer = void(*)(void);
 
     protected:
-        /// Packet FIFO buffer
-        using packet_fifo_type = util::fix_queue<packet_type, kMaxNrPackets>;
+        /// Policy of the packet FIFO if it is full
+        #if CFG_DCC_DECODER_FIFO_POLICY == OPT_DCC_DECODER_FIFO_DROP_OLDEST
+        static constexpr util::tSpscDropPolicy kFifoPolicy = util::SPSC_DROP_OLDEST;
+        #else
+        static constexpr util::tSpscDropPolicy kFifoPolicy = util::SPSC_DROP_NEWEST;
+        #endif
+
+        /// Packet FIFO: written by packet_received() (ISR or process_edges()), read by the main loop.
+        /// Stores packets or decoded commands (see CFG_DCC_DECODER_DECODED_COMMAND).
+        using packet_fifo_type = util::spsc_queue<value_type, CFG_DCC_DECODER_FIFO_SIZE, kFifoPolicy>;
+
+    public:
         using size_type = typename packet_fifo_type::size_type;
 
+        static const size_t kMaxNrPackets = packet_fifo_type::MaxSize; ///< Maximal number of packets stored in FIFO
+
         /**
          * @brief Constructor
          */
-        decoder() : my_packet_extractor(*this), my_bit_extractor(my_packet_extractor) 
+        decoder() : fifo_overflow(false), my_packet_extractor(*this), my_bit_extractor(my_packet_extractor) 
+        #if CFG_DCC_DECODER_CALIBRATION == OPT_DCC_DECODER_CALIBRATION_ON
+        , my_timing_calibration(my_bit_extractor)
+        #if CFG_DCC_DECODER_GLITCH_FILTER == OPT_DCC_DECODER_GLITCH_FILTER_ON
+        , my_glitch_filter(my_timing_calibration)
+        #endif
+        #elif CFG_DCC_DECODER_GLITCH_FILTER == OPT_DCC_DECODER_GLITCH_FILTER_ON
+        , my_glitch_filter(my_bit_extractor)
+        #endif
+        #if (CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON) && (CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_NONE)
+        , cv29(0)
+        #endif
+        #if CFG_DCC_DECODER_MODE == OPT_DCC_DECODER_MODE_DEFERRED
+        , edge_overrun_count(0)
+        , edge_gap(false)
+        #endif
+        , prev_edge_us(0)
+        , first_edge(true)
+        , packet_notification(nullptr)
         #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
         , packet_count(0)
+        , interrupt_count(0)
         #endif        
         {}
 
+    protected:
+
         /**
-         * @brief Packet FIFO buffers for double buffering.
-         * 
-         * Each buffer is used to store received packets. While one buffer is being filled by the ISR,
-         * the other buffer can be processed in the main loop.
+         * @brief Lock-free packet FIFO. The main loop reads packets without disabling interrupts.
          */
-        class double_buffer
-        {
-        public:
-            /** The two packet FIFOs for double buffering. */
-            packet_fifo_type packet_fifo[2];
-            /** Index for double buffering [0, 1] */
-            uint8 idx;
-            /** Indicates if an overflow has occurred in the double buffer */
-            bool overflow;
-            /** Constructor */
-            double_buffer() : idx{0}, overflow{false} {}
-            /** Toggle the buffer index between 0 and 1 */
-            void toggle() noexcept { idx = static_cast<uint8>(1U - idx); }
-            /** Return the index of the buffer currently used for writing */
-            uint_fast8_t write_index() const noexcept { return idx; }
-            /** Return the index of the buffer currently used for reading */
-            uint_fast8_t read_index() const noexcept { return static_cast<uint_fast8_t>(1U - idx); }
-            /** 
-             * Push a packet into the current buffer. If the buffer is full, set the overflow flag.
-             */
-            void push(const packet_type& pkt) 
-            { 
-                if (packet_fifo[write_index()].size() < packet_fifo[write_index()].max_size())
-                {
-                    packet_fifo[write_index()].push(pkt); 
-                }
-                else
-                {
-                    overflow = true;
-                }
-            }
-            /** Return reference to the front packet in the current read buffer */
-            packet_type &front() { return packet_fifo[read_index()].front(); }
-            /** Pop the front packet from the current read buffer */
-            void pop() { packet_fifo[read_index()].pop(); }
-            /** Check if the current read buffer is empty */
-            bool empty() const { return packet_fifo[read_index()].empty(); }
-            /** Return the size of the current read buffer */
-            size_type size() const { return packet_fifo[read_index()].size(); }
-            /** Check if an overflow has occurred in the double buffer. */
-            bool is_overflow() const noexcept { return overflow; }
-            /** Clear the overflow flag in the double buffer. */
-            void clear_overflow() noexcept { overflow = false; }
-        };
-
-        double_buffer packet_double_buffer;
+        packet_fifo_type packet_fifo;
+
+        /**
+         * @brief Set if a packet was dropped because the FIFO was full. Cleared by the main loop.
+         */
+        volatile bool fifo_overflow;
 
         /**
          * @brief Extractor for DCC packets from bit extractor.
@@ -117,16 +136,100 @@ namespace dcc
          */
         bit_extractor_type my_bit_extractor;
 
+        #if CFG_DCC_DECODER_CALIBRATION == OPT_DCC_DECODER_CALIBRATION_ON
+        /**
+         * @brief Scale time deltas to nominal before the bit extractor.
+         */
+        timing_calibration_type my_timing_calibration;
+        #endif
+
+        #if CFG_DCC_DECODER_GLITCH_FILTER == OPT_DCC_DECODER_GLITCH_FILTER_ON
+        /**
+         * @brief Merge spikes into half bits before the bit extractor.
+         */
+        glitch_filter_type my_glitch_filter;
+        #endif
+
+        #if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+        /**
+         * @brief Histogram of time deltas and packet count for signal quality metrics.
+         */
+        halfbit_histogram_type my_halfbit_histogram;
+        #endif
+
         /**
          * @brief Optional: use filter to filter packets.
          */
         filter_pointer_type filter_ptr;
+
+        #if CFG_DCC_DECODER_ADDRESS_FILTER != OPT_DCC_DECODER_ADDRESS_FILTER_NONE
+        /**
+         * @brief Address filter. Called directly (without indirection) before filter_ptr.
+         */
+        address_filter_type address_filter;
+        #endif
+
+        /**
+         * @brief Optional: use filter to suppress repeated packets (see dcc::repeat_filter).
+         * Evaluated after filter_ptr.
+         */
+        filter_pointer_type repeat_filter_ptr;
+
+        #if (CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON) && (CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_NONE)
+        /**
+         * @brief CV29 for the address of decoded commands (see set_cv29()).
+         */
+        uint8 cv29;
+        #endif
+
+        #if CFG_DCC_DECODER_MODE == OPT_DCC_DECODER_MODE_DEFERRED
+        /**
+         * @brief Time deltas [us] between edges, written by the ISR and decoded by process_edges().
+         */
+        util::spsc_queue<uint16, CFG_DCC_DECODER_EDGE_RING_SIZE> edge_ring;
+
+        /**
+         * @brief Number of edges lost because the edge ring was full. Can overflow. Written by
+         * the ISR.
+         */
+        volatile uint16 edge_overrun_count;
+
+        /**
+         * @brief True if edges were lost and the gap is not marked in the edge ring yet.
+         */
+        bool edge_gap;
+
+        /**
+         * @brief Time delta that marks lost edges in the edge ring. Is classified as invalid half bit.
+         */
+        static constexpr uint16 kEdgeGap = 0xFFFFU;
+        #endif
         
+        /**
+         * @brief [us] Time of the previous edge (see on_edge()).
+         */
+        unsigned long prev_edge_us;
+
+        /**
+         * @brief True until the first edge is received (the first edge has no time delta).
+         */
+        bool first_edge;
+
+        /**
+         * @brief Optional: called when a packet passed the filters (see set_packet_notification()).
+         */
+        notification_func_pointer packet_notification;
+
         #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
         /**
          * @brief Number of packets received since system start. Can overflow.
          */
         uint32 packet_count;
+
+        /**
+         * @brief Number of interrupts (edges) since system start. Can overflow.
+         */
+        uint32 interrupt_count;
         #endif
 
     public:
@@ -136,21 +239,24 @@ namespace dcc
         ~decoder() = default;
 
         /**
-         * @brief decoder is a singleton class and shall not be copied or assigned.
+         * @brief The ISR holds a pointer to the decoder, so it shall not be copied or assigned.
          */
         decoder(const decoder&) = delete;
         decoder& operator=(const decoder&) = delete;
 
         /**
-         * @brief decoder is a singleton class and shall not be moved.
+         * @brief The ISR holds a pointer to the decoder, so it shall not be moved.
          */
         decoder(decoder&&) = delete;
         decoder& operator=(decoder&&) = delete;
 
         /**
-         * @brief Get the singleton instance of the decoder.
+         * @brief Get the default instance of the decoder for applications with one DCC input.
+         * 
+         * The ISR does not use this function, so the guard of the static variable is not on the
+         * ISR path.
          * 
-         * @return Reference to the singleton decoder instance.
+         * @return Reference to the default decoder instance.
          */
         static decoder& get_instance()
         {
@@ -165,42 +271,179 @@ namespace dcc
          */
         bit_extractor_type& get_bit_extractor() noexcept { return my_bit_extractor; }
 
+        #if CFG_DCC_DECODER_GLITCH_FILTER == OPT_DCC_DECODER_GLITCH_FILTER_ON
+        /**
+         * @brief Returns reference to the glitch filter (e.g. for its counters).
+         * 
+         * @return Reference to the glitch filter.
+         */
+        glitch_filter_type& get_glitch_filter() noexcept { return my_glitch_filter; }
+        #endif
+
+        #if CFG_DCC_DECODER_CALIBRATION == OPT_DCC_DECODER_CALIBRATION_ON
+        /**
+         * @brief Returns reference to the timing calibration (e.g. for its scale factor).
+         * 
+         * @return Reference to the timing calibration.
+         */
+        timing_calibration_type& get_timing_calibration() noexcept { return my_timing_calibration; }
+        #endif
+
+        #if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+        /**
+         * @brief Returns reference to the histogram of time deltas (see halfbit_histogram::take()).
+         * 
+         * @return Reference to the histogram.
+         */
+        halfbit_histogram_type& get_halfbit_histogram() noexcept { return my_halfbit_histogram; }
+        #endif
+
+        /**
+         * @brief Decode a time delta: glitch filter (optional), timing calibration (optional) and
+         * bit extractor.
+         * 
+         * @param dt Time delta in microseconds.
+         */
+        void decode_edge(uint32 dt) noexcept
+        {
+            #if CFG_DCC_DECODER_GLITCH_FILTER == OPT_DCC_DECODER_GLITCH_FILTER_ON
+            my_glitch_filter.execute(dt);
+            #elif CFG_DCC_DECODER_CALIBRATION == OPT_DCC_DECODER_CALIBRATION_ON
+            my_timing_calibration.execute(dt);
+            #else
+            my_bit_extractor.execute(dt);
+            #endif
+        }
+
+        /**
+         * @brief Called by the ISR when a falling or rising edge has triggered the interrupt.
+         * 
+         * Calculates the time delta to the previous edge with hal::micros() and calls 
+         * edge_received(). The first edge is only stored.
+         */
+        void on_edge() noexcept;
+
+        /**
+         * @brief ISR with context pointer (see hal::attachInterrupt()).
+         * 
+         * @param ctx Pointer to the decoder
+         */
+        static void isr(void* ctx) noexcept { static_cast<decoder*>(ctx)->on_edge(); }
+
+        /**
+         * @brief Called by on_edge() with the time delta between the current and the previous edge.
+         * 
+         * In ISR mode, the edge is decoded immediately. In deferred mode, the edge is stored in the
+         * edge ring and decoded later by process_edges().
+         * 
+         * If the edge ring is full, the edge is lost and counted. The gap is marked in the edge ring
+         * with an invalid time delta as soon as there is space again so that the extractors restart
+         * with the next preamble.
+         * 
+         * @param dt Time delta in microseconds, clamped to 0xFFFF in deferred mode.
+         */
+        void edge_received(uint32 dt) noexcept
+        {
+            #if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+            my_halfbit_histogram.add(dt);
+            #endif
+            #if CFG_DCC_DECODER_MODE == OPT_DCC_DECODER_MODE_DEFERRED
+            const uint16 dt16 = (dt > kEdgeGap) ? kEdgeGap : static_cast<uint16>(dt);
+            if (edge_gap)
+            {
+                // Mark the position of lost edges so that process_edges() resets the extractors
+                edge_gap = !edge_ring.push(kEdgeGap);
+            }
+            if (edge_gap || !edge_ring.push(dt16))
+            {
+                edge_gap = true;
+                edge_overrun_count++;
+            }
+            #else
+            decode_edge(dt);
+            #endif
+        }
+
         /**
-         * @brief Initialize with interrupt pin
+         * @brief Decode all edges that the ISR has stored since the last call.
+         * 
+         * Shall be called from the main loop (e.g. before fetch()) often enough so that the edge
+         * ring does not overflow. Does nothing in ISR mode.
+         */
+        void process_edges();
+
+        /**
+         * @brief Returns the number of edges lost because the edge ring was full (deferred mode).
+         * 
+         * The ISR writes the 16 bit counter with two bytes on 8-bit targets, so it is read with
+         * interrupts suspended. Shall be called from the main loop.
+         *
+         * @return Number of lost edges, always 0 in ISR mode. Can overflow.
+         */
+        uint16 get_edge_overrun_count() const noexcept
+        {
+            #if CFG_DCC_DECODER_MODE == OPT_DCC_DECODER_MODE_DEFERRED
+            SuspendAllInterrupts();
+            const uint16 count = edge_overrun_count;
+            ResumeAllInterrupts();
+            return count;
+            #else
+            return 0U;
+            #endif
+        }
+
+        /**
+         * @brief Initialize with interrupt pin. Attaches on_edge() of this decoder to the 
+         * interrupt of the pin.
          * 
          * @param ucIntPin Interrupt pin number
+         * @return true if the interrupt is attached, false if the pin has no supported interrupt
          */
-        void init(uint8 ucIntPin);
+        bool init(uint8 ucIntPin);
 
         /**
-         * @brief Switch the packet buffers and prepare for reading from the current read FIFO.
+         * @brief Prepare for reading packets.
+         * 
+         * Packets are available as soon as they are received, so there is nothing to do. Kept for 
+         * compatibility with the former double buffer.
          */
-        void fetch();
+        void fetch() noexcept {}
         /** 
-         * @brief Returns reference to the front packet in the current read FIFO.
+         * @brief Returns reference to the front packet (or decoded command, see 
+         * CFG_DCC_DECODER_DECODED_COMMAND) in the FIFO. The reference is valid until pop().
          */
-        packet_type &front() { return packet_double_buffer.front(); }
+        value_type &front() noexcept { return packet_fifo.front(); }
         /** 
-         * @brief Pop the front packet from the current read FIFO.
+         * @brief Pop the front packet from the FIFO.
          */
-        void pop() { return packet_double_buffer.pop(); }
+        void pop() noexcept { packet_fifo.pop(); }
         /** 
-         * @brief Check if the current read FIFO is empty.
+         * @brief Check if the FIFO is empty.
          */
-        bool empty() const { return packet_double_buffer.empty(); }
+        bool empty() const noexcept { return packet_fifo.empty(); }
         /** 
-         * @brief Return the size of the current read FIFO.
+         * @brief Return the number of packets in the FIFO.
          */
-        size_type size() const { return packet_double_buffer.size(); }
+        size_type size() const noexcept { return packet_fifo.size(); }
 
         /** 
-         * @brief Check if an overflow has occurred in the double buffer.
+         * @brief Check if a packet was dropped because the FIFO was full.
          */
-        bool is_fifo_overflow() const noexcept { return packet_double_buffer.is_overflow(); }
+        bool is_fifo_overflow() const noexcept { return fifo_overflow; }
         /** 
-         * @brief Clear the overflow flag in the double buffer.
+         * @brief Clear the overflow flag.
          */
-        void clear_fifo_overflow() noexcept { packet_double_buffer.clear_overflow(); }
+        void clear_fifo_overflow() noexcept { fifo_overflow = false; }
+        /** 
+         * @brief Return the maximal number of packets that were stored in the FIFO at the same time.
+         */
+        size_type get_fifo_high_watermark() const noexcept { return packet_fifo.get_high_watermark(); }
+        /** 
+         * @brief Return the number of packets dropped because the FIFO was full. Can overflow.
+         * 
+         * Depending on CFG_DCC_DECODER_FIFO_POLICY, the new or the oldest packet is dropped.
+         */
+        uint16 get_fifo_drop_count() const noexcept { return packet_fifo.get_drop_count(); }
 
         /**
          * @brief Set the filter for incoming packets. Only packets that pass the filter are 
@@ -210,24 +453,106 @@ namespace dcc
          */
         void set_filter(const filter_type &filter) { filter_ptr = &filter; }
 
+        #if CFG_DCC_DECODER_ADDRESS_FILTER != OPT_DCC_DECODER_ADDRESS_FILTER_NONE
+        /**
+         * @brief Returns the address filter. Only packets for addresses that are set in the 
+         * address filter are forwarded. By default, no address is set.
+         * 
+         * @note Modify the address filter from the main loop only.
+         */
+        address_filter_type &get_address_filter() noexcept { return address_filter; }
+        #endif
+
         /**
-         * @brief Called when a new packet is received. Can be called from an ISR context.
+         * @brief Set the repeat filter, e.g. dcc::repeat_filter. It is called for packets that 
+         * passed the filter (see set_filter()), so repetitions of packets for other decoders do
+         * not occupy its entries. Only packets that pass both filters are enqueued.
+         * 
+         * @param filter Reference to the repeat filter to be used.
+         */
+        void set_repeat_filter(const filter_type &filter) { repeat_filter_ptr = &filter; }
+
+        /**
+         * @brief Set a function that is called when a packet passed the filters and is committed to
+         * the FIFO (also if the FIFO overflows), e.g. to set an event so that the main loop
+         * processes the packet without waiting for its next cycle (see rte::setEvent()). Called
+         * from the ISR in ISR mode and from process_edges() in deferred mode, so the function
+         * shall be short.
+         * 
+         * @param func The function, or nullptr to call no function
+         */
+        void set_packet_notification(notification_func_pointer func) noexcept { packet_notification = func; }
+
+        #if CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON
+        #if CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_NONE
+        /**
+         * @brief Set CV29 for the address of decoded commands (accessory address method).
+         * 
+         * @param cv29_value The value of CV29 from the decoder's configuration.
+         */
+        void set_cv29(uint8 cv29_value) noexcept { cv29 = cv29_value; }
+
+        /**
+         * @brief Returns CV29 for the address of decoded commands.
+         */
+        uint8 get_cv29() const noexcept { return cv29; }
+        #else
+        /**
+         * @brief Returns CV29 for the address of decoded commands. The address filter owns CV29 
+         * (see address_filter_type::set_cv29()).
+         */
+        uint8 get_cv29() const noexcept { return address_filter.get_cv29(); }
+        #endif
+        #endif
+
+        /**
+         * @brief Called when a new packet is received. Called from the ISR in ISR mode and from 
+         * process_edges() in deferred mode.
          * 
          * @note pkt is not const to allow modification, e.g., for type calculation.
          * @note Can be called from an ISR context.
          * 
          * @param pkt Reference to the received DCC packet
          */
-        virtual void packet_received(packet_type& pkt) override 
+        void packet_received(packet_type& pkt) noexcept
         {
             bool process_packet = true;
-            if (filter_ptr && (!filter_ptr->do_filter(pkt)))
+            #if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+            my_halfbit_histogram.add_packet();
+            #endif
+            #if CFG_DCC_DECODER_ADDRESS_FILTER != OPT_DCC_DECODER_ADDRESS_FILTER_NONE
+            // address_filter_type is final: no indirect call
+            process_packet = address_filter.do_filter(pkt);
+            #endif
+            if (process_packet && filter_ptr)
+            {
+                process_packet = filter_ptr->do_filter(pkt);
+            }
+            if (process_packet && repeat_filter_ptr)
             {
-                process_packet = false;
+                process_packet = repeat_filter_ptr->do_filter(pkt);
             }
             if (process_packet)
             {
-                packet_double_buffer.push(pkt);
+                #if CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON
+                // decode once; the filters above have cached type and address in the packet
+                packet_fifo.back_slot().assign(pkt, get_cv29());
+                #else
+                packet_type &slot = packet_fifo.back_slot();
+                // copy only if the packet was not assembled in place (see get_packet_slot())
+                if (&pkt != &slot)
+                {
+                    slot = pkt;
+                }
+                #endif
+                if (!packet_fifo.commit())
+                {
+                    fifo_overflow = true;
+                }
+                if (packet_notification != nullptr)
+                {
+                    packet_notification();
+                }
             }
             #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
             packet_count++;
@@ -235,32 +560,51 @@ namespace dcc
         }
 
         /**
-         * @brief Handles the reception of basic DCC accessory packets.
-         * 
-         * This function processes basic DCC packets. It calculates the command from the packet's
-         * address and the output direction, and forwards the result to the RTE. The position on RTE 
-         * is calculated from the DCC address of the packet minus the first output address.
-         * 
-         * @param pkt Reference to the received DCC packet
-         */
-        virtual void basic_packet_received(packet_type& pkt) { (void) pkt; }
-        
-        /**
-         * @brief Handles the reception of extended DCC accessory packets.
+         * @brief Returns the free slot of the packet FIFO so that the packet extractor assembles
+         * the next packet in place. packet_received() commits the slot without a copy.
          * 
-         * This function processes extended DCC packets. It forwards the aspect value to the RTE.
-         * The position on RTE is calculated from the DCC address of the packet minus the first output
-         * address.
+         * If the FIFO stores decoded commands, returns nullptr: the packet extractor assembles the
+         * packet in its own packet.
          * 
-         * @param pkt Reference to the received DCC packet
+         * @note Can be called from an ISR context.
          */
-        virtual void extended_packet_received(packet_type& pkt) { (void) pkt; }
+        packet_type* get_packet_slot() noexcept
+        {
+            #if CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON
+            return nullptr;
+            #else
+            return &packet_fifo.back_slot();
+            #endif
+        }
+
         /**
-         * @brief 
-         * 
-         * @param pkt 
+         * @brief Called by the packet extractor after the first byte of a packet if
+         * CFG_DCC_DECODER_EARLY_REJECT is on. Packets that cannot pass the address filter are
+         * skipped without assembling them and are not passed to the filters (see set_filter()).
+         * The half bit histogram counts skipped packets here. Without address filter, all packets
+         * are accepted.
+         *
+         * @note Can be called from an ISR context.
+         *
+         * @param byte0 The first byte of the packet (primary address)
+         * @return false if the packet shall be skipped
          */
-        virtual void any_packet_received(packet_type& pkt) { (void) pkt; }
+        bool accept_first_byte(uint8 byte0) noexcept
+        {
+            #if CFG_DCC_DECODER_ADDRESS_FILTER != OPT_DCC_DECODER_ADDRESS_FILTER_NONE
+            const bool accept = address_filter.may_pass(byte0);
+            #if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+            if (!accept)
+            {
+                my_halfbit_histogram.add_packet();
+            }
+            #endif
+            return accept;
+            #else
+            (void) byte0;
+            return true;
+            #endif
+        }
 
         /**
          * @brief Check if an overflow has occurred in the ISR context.
@@ -272,10 +616,11 @@ namespace dcc
         #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
         /// For debugging: get number of interrupts called since system start.
         /// Counter can overflow and start at 0 again.
-        uint32 get_interrupt_count() const;
+        uint32 get_interrupt_count() const noexcept { return interrupt_count; }
         uint32 get_ones_count() const { return my_packet_extractor.ones_count; }
         uint32 get_zeros_count() const { return my_packet_extractor.zeros_count; }
         uint32 get_invalids_count() const { return my_packet_extractor.invalids_count; }
+        uint32 get_checksum_errors_count() const { return my_packet_extractor.checksum_errors_count; }
         uint32 get_packet_count() const noexcept { return packet_count; }
         /**
          * @brief Get the bit extractor call count object
@@ -0,0 +1,222 @@
+/**
+ * @file Encoder.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::encoder that turns DCC packets into time deltas between edges
+ *
+ * The encoder is the opposite of dcc::bit_extractor: it produces the time deltas ("half bits") that
+ * a command station puts on the track for a packet. It is used on the host to feed the decoder with
+ * traffic (benchmarks, loss rates) without hardware.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_ENCODER_H
+#define DCC_ENCODER_H
+
+#include <Std_Types.h>
+#include <Dcc/Packet.h>
+
+namespace dcc
+{
+  /**
+   * @brief Configuration of dcc::encoder
+   */
+  struct encoder_config
+  {
+    /// Number of "1" bits in the preamble (NMRA S-9.2: at least 14 for command stations)
+    uint8 preamble_nr_ones;
+    /// [us] Time of a half bit of a "1" (NMRA S-9.1: 58 us)
+    uint16 one_us;
+    /// [us] Time of a half bit of a "0" (NMRA S-9.1: at least 100 us)
+    uint16 zero_us;
+    /// [us] Maximal jitter; each half bit is changed by a random value in [-jitter_us, +jitter_us]
+    uint8 jitter_us;
+    /// [us] Length of a cutout after the end bit (e.g. RailCom: 464 us); 0 for no cutout
+    uint16 cutout_us;
+    /// Probability that a bit is inverted, in units of 1/65536; 0 for no bit errors
+    uint16 bit_error_rate;
+    /// Probability that a half bit contains a spike, in units of 1/65536; 0 for no spikes
+    uint16 spike_rate;
+    /// [us] Maximal width of a spike (two additional edges within a half bit)
+    uint8 spike_us;
+  };
+
+  // ---------------------------------------------------------------------
+  /// Encodes DCC packets into time deltas between edges [us].
+  ///
+  /// A packet is encoded as preamble ("1" bits), a "0" start bit before each byte, the bytes
+  /// (MSB first) and a "1" end bit. Each bit is encoded as two half bits. The bytes of the packet
+  /// are sent as they are; the checksum is not added.
+  ///
+  /// Disturbances are optional (see encoder_config):
+  /// - jitter: each half bit is changed by a random value,
+  /// - cutout: a long gap after the end bit (the next edge is the first edge of the next preamble),
+  /// - bit errors: a bit is inverted (both half bits),
+  /// - spikes: a half bit t is split into three time deltas a, s, c with a + s + c = t and a short
+  ///   spike s of at most spike_us.
+  ///
+  /// Random numbers are generated by a xorshift generator with a fixed seed, so the output
+  /// is reproducible.
+  ///
+  /// The time deltas are passed to a sink (e.g. a lambda that calls bit_extractor::execute())
+  /// or are written into a buffer (e.g. for bit_extractor::execute_many()).
+  ///
+  /// @tparam Packet Type of Dcc Packet such as dcc::packet<>
+  // ---------------------------------------------------------------------
+  template<class Packet = packet<> >
+  class encoder
+  {
+  public:
+    using packet_type = Packet;
+    using config_type = encoder_config;
+
+    /// Returns the default configuration: 14 preamble bits, 58 us and 100 us, no disturbances
+    static constexpr config_type default_config() noexcept { return config_type{ 14U, 58U, 100U, 0U, 0U, 0U, 0U, 0U }; }
+
+    /// Returns the maximal number of time deltas of a packet with nr_bytes bytes and nr_preamble_ones preamble bits
+    /// (with spikes, a half bit is encoded as three time deltas)
+    static constexpr size_t max_nr_deltas(size_t nr_bytes, size_t nr_preamble_ones) noexcept
+    {
+      return 6U * (nr_preamble_ones + 9U * nr_bytes + 1U) + 1U;
+    }
+
+  protected:
+    /// The configuration
+    config_type cfg;
+    /// State of the random number generator
+    uint32 rng_state;
+    /// Number of inverted bits. Can overflow.
+    uint32 bit_error_count;
+    /// Number of spikes. Can overflow.
+    uint32 spike_count;
+
+    /// Returns the next random number (xorshift32)
+    uint32 next_random() noexcept
+    {
+      rng_state ^= rng_state << 13U;
+      rng_state ^= rng_state >> 17U;
+      rng_state ^= rng_state << 5U;
+      return rng_state;
+    }
+
+    /// Returns t with jitter
+    uint16 jitter(uint16 t) noexcept
+    {
+      uint16 ret = t;
+      if (cfg.jitter_us > 0U)
+      {
+        const uint32 range = 2U * static_cast<uint32>(cfg.jitter_us) + 1U;
+        const sint32 dt = static_cast<sint32>(next_random() % range) - static_cast<sint32>(cfg.jitter_us);
+        const sint32 tj = static_cast<sint32>(t) + dt;
+        ret = static_cast<uint16>((tj > 1) ? tj : 1);
+      }
+      return ret;
+    }
+
+    /// Encode a bit with two half bits
+    template<class Sink>
+    void encode_bit(bool one, Sink& sink) noexcept
+    {
+      if ((cfg.bit_error_rate > 0U) && ((next_random() & 0xFFFFU) < cfg.bit_error_rate))
+      {
+        one = !one;
+        bit_error_count++;
+      }
+      const uint16 t = one ? cfg.one_us : cfg.zero_us;
+      encode_half_bit(jitter(t), sink);
+      encode_half_bit(jitter(t), sink);
+    }
+
+    /// Encode a half bit of time t, optionally with a spike
+    template<class Sink>
+    void encode_half_bit(uint16 t, Sink& sink) noexcept
+    {
+      if ((cfg.spike_rate > 0U) && (cfg.spike_us > 0U) && (t > cfg.spike_us + 2U) && ((next_random() & 0xFFFFU) < cfg.spike_rate))
+      {
+        const uint16 ts = static_cast<uint16>(1U + next_random() % cfg.spike_us);
+        const uint16 ta = static_cast<uint16>(1U + next_random() % static_cast<uint32>(t - ts - 1U));
+        sink(ta);
+        sink(ts);
+        sink(static_cast<uint16>(t - ta - ts));
+        spike_count++;
+      }
+      else
+      {
+        sink(t);
+      }
+    }
+
+  public:
+    /// Construct with configuration c and seed for the random number generator (must not be 0)
+    encoder(const config_type& c = default_config(), uint32 seed = 0x12345678U) noexcept
+      : cfg(c), rng_state((seed != 0U) ? seed : 1U), bit_error_count(0U), spike_count(0U)
+    {
+    }
+
+    /// Set the configuration
+    void set_config(const config_type& c) noexcept { cfg = c; }
+    /// Returns the configuration
+    const config_type& get_config() const noexcept { return cfg; }
+
+    /// Returns the number of inverted bits (see encoder_config::bit_error_rate). Can overflow.
+    uint32 get_bit_error_count() const noexcept { return bit_error_count; }
+    /// Returns the number of spikes (see encoder_config::spike_rate). Can overflow.
+    uint32 get_spike_count() const noexcept { return spike_count; }
+
+    /**
+     * @brief Encode a packet. The time deltas are passed to sink.
+     *
+     * @param pkt The packet
+     * @param sink A callable with one parameter of type uint16 (time delta [us])
+     */
+    template<class Sink>
+    void encode(const packet_type& pkt, Sink&& sink) noexcept
+    {
+      for (uint8 i = 0U; i < cfg.preamble_nr_ones; i++)
+      {
+        encode_bit(true, sink);
+      }
+      for (auto it = pkt.begin(); it != pkt.end_used(); it++)
+      {
+        encode_bit(false, sink);
+        for (uint8 mask = 0x80U; mask != 0U; mask = static_cast<uint8>(mask >> 1U))
+        {
+          encode_bit((*it & mask) != 0U, sink);
+        }
+      }
+      encode_bit(true, sink);
+      if (cfg.cutout_us > 0U)
+      {
+        sink(cfg.cutout_us);
+      }
+    }
+
+    /**
+     * @brief Encode a packet into buffer deltas.
+     *
+     * @param pkt The packet
+     * @param deltas The buffer for time deltas [us]
+     * @param capacity Number of elements of deltas. Time deltas that do not fit are dropped.
+     * @return Number of time deltas written into deltas
+     */
+    size_t encode(const packet_type& pkt, uint16 *deltas, size_t capacity) noexcept
+    {
+      size_t n = 0U;
+      encode(pkt, [deltas, capacity, &n](uint16 dt)
+      {
+        if (n < capacity)
+        {
+          deltas[n] = dt;
+          n++;
+        }
+      });
+      return n;
+    }
+  };
+} // namespace dcc
+
+#endif // DCC_ENCODER_H
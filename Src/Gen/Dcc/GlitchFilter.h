@@ -0,0 +1,178 @@
+/**
+ * @file GlitchFilter.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::glitch_filter that removes short spikes from the time deltas between
+ * edges before they reach dcc::bit_extractor
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_GLITCHFILTER_H
+#define DCC_GLITCHFILTER_H
+
+#include <Std_Types.h>
+#include <Dcc/DecoderCfg.h>
+#include <Dcc/BitExtractor.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// Pre-filter for time deltas between edges [us] in front of the bit extractor.
+  ///
+  /// A spike on the track signal adds two edges within a half bit, so the half bit t arrives as
+  /// three time deltas a, s, c with a + s + c = t and a short s. The bit extractor classifies
+  /// these deltas as invalid and loses the packet in progress and the following preamble.
+  ///
+  /// The glitch filter merges a time delta below GlitchMax and the following time delta into the
+  /// current half bit, so a, s, c is forwarded as t.
+  ///
+  /// If a spike is close to the start of a half bit, a and s are both below GlitchMax (a glitch
+  /// pair) and the current half bit is already complete. Merging a and s into it would turn a
+  /// "1" half bit into a "0" or an invalid one. So if the current half bit is a valid half bit
+  /// (see TConstants) when a glitch pair arrives, it is forwarded and a + s starts the next half
+  /// bit. Otherwise, the glitch pair is the end of the current half bit (spike close to its end).
+  ///
+  /// If more than MaxGlitchesPerBit glitches occur within the current and the previous half bit,
+  /// the signal is regarded as disturbed: an invalid time delta (0) is forwarded so that the bit
+  /// extractor restarts with the next preamble.
+  ///
+  /// A half bit is forwarded when the first edge of the next half bit arrives, so bits are
+  /// decoded one half bit later than without the glitch filter.
+  ///
+  /// @tparam TBitExtractor     Class that receives time deltas (must provide execute(uint32_t))
+  /// @tparam GlitchMax         [us] Time deltas below this value are glitches
+  /// @tparam MaxGlitchesPerBit Maximal number of glitches within two subsequent half bits
+  /// @tparam TConstants        Valid half bits (see dcc::bit_extractor_constants)
+  // ---------------------------------------------------------------------
+  template<class TBitExtractor, uint16 GlitchMax = CFG_DCC_DECODER_GLITCH_MAX_US, uint8 MaxGlitchesPerBit = CFG_DCC_DECODER_GLITCH_MAX_PER_BIT,
+           class TConstants = bit_extractor_constants<> >
+  class glitch_filter
+  {
+  public:
+    using bit_extractor_type = TBitExtractor;
+
+    /// [us] Time deltas below this value are glitches
+    static constexpr uint16 kGlitchMax = GlitchMax;
+    /// Maximal number of glitches within two subsequent half bits
+    static constexpr uint8 kMaxGlitchesPerBit = MaxGlitchesPerBit;
+
+  protected:
+    /// The bit extractor that receives the filtered time deltas
+    bit_extractor_type& bit_extractor;
+    /// [us] The current half bit (sum of merged time deltas); 0 if there is none
+    uint32 pending;
+    /// True if the next time delta belongs to the current half bit (second edge of a spike)
+    bool merge_next;
+    /// [us] The glitch that was added to pending last (first edge of a spike)
+    uint32 glitch;
+    /// Number of glitches in the current and in the previous half bit
+    uint8 glitches_current;
+    uint8 glitches_previous;
+    /// Number of merged glitches. Can overflow.
+    uint16 glitch_count;
+    /// Number of resets because of too many glitches. Can overflow.
+    uint16 reset_count;
+
+    /// Returns true if dt is a valid "1" or "0" half bit
+    static constexpr bool is_half_bit(uint32 dt) noexcept
+    {
+      return ((dt >= TConstants::kPartTimeShortMin) && (dt <= TConstants::kPartTimeShortMax)) ||
+             ((dt >= TConstants::kPartTimeLongMin) && (dt <= TConstants::kPartTimeLongMax));
+    }
+
+    /// Forward the current half bit and start a new one with time delta dt
+    void forward(uint32 dt)
+    {
+      if (pending > 0U)
+      {
+        bit_extractor.execute(pending);
+      }
+      pending = dt;
+      glitches_previous = glitches_current;
+      glitches_current = 0U;
+    }
+
+  public:
+    /// Construct with a reference to the bit extractor
+    glitch_filter(bit_extractor_type& be) noexcept
+      : bit_extractor(be), pending(0U), merge_next(false), glitch(0U), glitches_current(0U), glitches_previous(0U), glitch_count(0U), reset_count(0U)
+    {
+    }
+
+    /**
+     * @brief Filter a time delta and forward complete half bits to the bit extractor.
+     *
+     * @param dt Time difference in microseconds since the last edge.
+     */
+    void execute(uint32 dt)
+    {
+      if (merge_next)
+      {
+        const uint32 previous = pending - glitch;
+        if ((dt < kGlitchMax) && is_half_bit(previous))
+        {
+          // glitch pair close to the start of a half bit: the previous half bit is complete,
+          // the next time delta completes the new half bit. The glitch counts for the new half bit.
+          pending = previous;
+          glitches_current--;
+          forward(glitch + dt);
+          glitches_current = 1U;
+        }
+        else
+        {
+          // second edge of a spike: the remainder of the half bit
+          pending += dt;
+          merge_next = false;
+        }
+      }
+      else if (dt < kGlitchMax)
+      {
+        glitch_count++;
+        glitches_current++;
+        if (static_cast<uint8>(glitches_current + glitches_previous) > kMaxGlitchesPerBit)
+        {
+          reset_count++;
+          bit_extractor.execute(0U);
+          pending = 0U;
+          glitches_current = 0U;
+          glitches_previous = 0U;
+        }
+        else
+        {
+          pending += dt;
+          glitch = dt;
+          merge_next = true;
+        }
+      }
+      else
+      {
+        forward(dt);
+      }
+    }
+
+    /**
+     * @brief Filter a buffer of time differences (see execute()).
+     *
+     * @param deltas Time differences in microseconds between subsequent edges.
+     * @param n      Number of elements in deltas.
+     */
+    void execute_many(const uint16 *deltas, size_t n)
+    {
+      for (size_t i = 0U; i < n; i++)
+      {
+        execute(deltas[i]);
+      }
+    }
+
+    /// Returns the number of merged glitches. Can overflow.
+    uint16 get_glitch_count() const noexcept { return glitch_count; }
+    /// Returns the number of resets of the bit extractor because of too many glitches. Can overflow.
+    uint16 get_reset_count() const noexcept { return reset_count; }
+  };
+} // namespace dcc
+
+#endif // DCC_GLITCHFILTER_H
@@ -0,0 +1,219 @@
+/**
+ * @file HalfBitHistogram.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::halfbit_histogram that collects a histogram of the time deltas
+ * between edges and derives signal quality metrics from it
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_HALFBITHISTOGRAM_H
+#define DCC_HALFBITHISTOGRAM_H
+
+#include <Std_Types.h>
+#include <Dcc/BitExtractor.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// Histogram of the time deltas between edges ("half bits") for signal quality metrics.
+  ///
+  /// The ISR adds each time delta with add() (one increment), the decoder adds each received
+  /// packet with add_packet(). The main loop takes the counters periodically with take() and
+  /// derives metrics with evaluate(), e.g. to tune bit_extractor_constants per installation.
+  ///
+  /// Bins (with the defaults 40 us, 4 us, 25 bins):
+  ///
+  ///     bin    0        1           2                25          26
+  ///         |------|---------|---------| ... |-------------|----------->
+  ///         0     40        44        48     136           140
+  ///
+  /// The counters are double buffered: take() switches the buffer for add() and reads the
+  /// other buffer, so the ISR is not locked. The counters are 16 bit and can overflow; take()
+  /// shall be called at least every 4 s (about 14000 edges per second).
+  ///
+  /// @tparam FirstUs                [us] Lower limit of bin 1 (bin 0 counts shorter time deltas)
+  /// @tparam BinWidthUs             [us] Width of the bins, a power of 2
+  /// @tparam NrBins                 Number of bins between the first and the overflow bin
+  /// @tparam TBitExtractorConstants Thresholds for short and long half bits (see bit_extractor_constants)
+  // ---------------------------------------------------------------------
+  template<uint16 FirstUs = 40U, uint16 BinWidthUs = 4U, uint8 NrBins = 25U, class TBitExtractorConstants = bit_extractor_constants<> >
+  class halfbit_histogram
+  {
+  public:
+    static_assert((BinWidthUs > 0U) && ((BinWidthUs & (BinWidthUs - 1U)) == 0U), "halfbit_histogram: BinWidthUs must be a power of 2");
+
+    /// Number of bins including the underflow bin (0) and the overflow bin (kNrBins - 1)
+    static constexpr uint8 kNrBins = NrBins + 2U;
+    /// [us] Lower limit of the overflow bin
+    static constexpr uint32 kOverflowUs = static_cast<uint32>(FirstUs) + static_cast<uint32>(NrBins) * BinWidthUs;
+
+    /// Counters of a measurement window
+    struct counters_type
+    {
+      /// Number of time deltas per bin
+      uint16 bins[kNrBins];
+      /// Number of received packets
+      uint16 nr_packets;
+      /// Number of subsequent short half bits (saturates)
+      uint16 nr_short_pairs;
+      /// [us] Sum of the differences between subsequent short half bits
+      uint32 short_diff_sum;
+    };
+
+    /// Index of the metrics in an array (see evaluate())
+    enum : uint8
+    {
+      kMeanShort        = 0, ///< [0.1 us] Mean of the short half bits
+      kMeanLong         = 1, ///< [0.1 us] Mean of the long half bits below the overflow bin
+      kAsymmetry        = 2, ///< [0.1 us] Mean deviation of a short half bit from the mean of two subsequent short half bits
+      kOutOfSpec        = 3, ///< [0.1 %] Time deltas that are neither short nor long
+      kPacketsPerSecond = 4, ///< Received packets per second
+      kNrMetrics        = 5  ///< Number of metrics
+    };
+
+  protected:
+    static constexpr uint32 kShortMin = TBitExtractorConstants::kPartTimeShortMin;
+    static constexpr uint32 kShortMax = TBitExtractorConstants::kPartTimeShortMax;
+    static constexpr uint32 kLongMin = TBitExtractorConstants::kPartTimeLongMin;
+
+    /// Returns log2 of x
+    static constexpr uint8 log2(uint32 x) noexcept { return (x > 1U) ? static_cast<uint8>(1U + log2(x >> 1U)) : 0U; }
+    static constexpr uint8 kBinShift = log2(BinWidthUs);
+
+    /// Double buffer of counters; add() writes counters[active]
+    counters_type counters[2];
+    volatile uint8 active;
+    /// [us] Previous time delta if it was a short half bit, 0 otherwise
+    uint16 prev_short;
+
+    static void clear(counters_type& c) noexcept
+    {
+      for (uint8 i = 0U; i < kNrBins; i++)
+      {
+        c.bins[i] = 0U;
+      }
+      c.nr_packets = 0U;
+      c.nr_short_pairs = 0U;
+      c.short_diff_sum = 0U;
+    }
+
+    /// [0.1 us] Returns the center of bin i [1, kNrBins - 2]
+    static constexpr uint32 bin_center(uint8 i) noexcept
+    {
+      return 10U * (static_cast<uint32>(FirstUs) + (static_cast<uint32>(i - 1U) << kBinShift)) + 5U * BinWidthUs;
+    }
+
+  public:
+    /// Construct with empty counters
+    halfbit_histogram() noexcept : active(0U), prev_short(0U)
+    {
+      clear(counters[0]);
+      clear(counters[1]);
+    }
+
+    /**
+     * @brief Add a time delta. Called from the ISR.
+     *
+     * @param dt Time difference in microseconds since the last edge.
+     */
+    void add(uint32 dt) noexcept
+    {
+      counters_type& c = counters[active];
+      uint32 i = 0U;
+      if (dt >= FirstUs)
+      {
+        i = ((dt - FirstUs) >> kBinShift) + 1U;
+        if (i > kNrBins - 1U)
+        {
+          i = kNrBins - 1U;
+        }
+      }
+      c.bins[i]++;
+
+      if ((dt >= kShortMin) && (dt <= kShortMax))
+      {
+        if ((prev_short > 0U) && (c.nr_short_pairs < 0xFFFFU))
+        {
+          c.short_diff_sum += (dt > prev_short) ? (dt - prev_short) : (prev_short - dt);
+          c.nr_short_pairs++;
+        }
+        prev_short = static_cast<uint16>(dt);
+      }
+      else
+      {
+        prev_short = 0U;
+      }
+    }
+
+    /// Add a received packet. Called from the ISR (ISR mode) or from the main loop (deferred mode).
+    void add_packet() noexcept { counters[active].nr_packets++; }
+
+    /**
+     * @brief Returns the counters since the last call and starts a new measurement window.
+     * Called from the main loop.
+     *
+     * @param c The counters of the measurement window
+     */
+    void take(counters_type& c) noexcept
+    {
+      const uint8 a = active;
+      active = static_cast<uint8>(a ^ 1U);
+      c = counters[a];
+      clear(counters[a]);
+    }
+
+    /**
+     * @brief Derive signal quality metrics from the counters of a measurement window.
+     *
+     * The bins are classified as short, long or out of spec by their centers, so the metrics
+     * have the resolution of the bins.
+     *
+     * @param c         Counters of the measurement window (see take())
+     * @param window_ms [ms] Length of the measurement window
+     * @param metrics   Array with at least kNrMetrics elements of type uint16
+     */
+    template<class Array>
+    static void evaluate(const counters_type& c, uint32 window_ms, Array& metrics) noexcept
+    {
+      uint32 nr_short = 0U;
+      uint32 sum_short = 0U;
+      uint32 nr_long = 0U;
+      uint32 sum_long = 0U;
+      uint32 nr_out = c.bins[0];
+      uint32 nr_total = static_cast<uint32>(c.bins[0]) + c.bins[kNrBins - 1U];
+      for (uint8 i = 1U; i < kNrBins - 1U; i++)
+      {
+        const uint32 center = bin_center(i);
+        const uint32 n = c.bins[i];
+        nr_total += n;
+        if ((center >= 10U * kShortMin) && (center <= 10U * kShortMax))
+        {
+          nr_short += n;
+          sum_short += n * center;
+        }
+        else if (center >= 10U * kLongMin)
+        {
+          nr_long += n;
+          sum_long += n * center;
+        }
+        else
+        {
+          nr_out += n;
+        }
+      }
+      metrics[kMeanShort] = static_cast<uint16>((nr_short > 0U) ? sum_short / nr_short : 0U);
+      metrics[kMeanLong] = static_cast<uint16>((nr_long > 0U) ? sum_long / nr_long : 0U);
+      // subsequent short half bits h1 = m + a, h2 = m - a differ by 2 * a
+      metrics[kAsymmetry] = static_cast<uint16>((c.nr_short_pairs > 0U) ? (5U * c.short_diff_sum) / c.nr_short_pairs : 0U);
+      metrics[kOutOfSpec] = static_cast<uint16>((nr_total > 0U) ? (1000U * nr_out) / nr_total : 0U);
+      metrics[kPacketsPerSecond] = static_cast<uint16>((window_ms > 0U) ? (1000U * static_cast<uint32>(c.nr_packets)) / window_ms : 0U);
+    }
+  };
+} // namespace dcc
+
+#endif // DCC_HALFBITHISTOGRAM_H
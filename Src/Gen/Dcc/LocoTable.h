@@ -0,0 +1,319 @@
+/**
+ * @file LocoTable.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::loco_table that decodes multi function (locomotive) packets into a
+ * table of speed, direction and function states indexed by address
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_LOCOTABLE_H
+#define DCC_LOCOTABLE_H
+
+#include <Std_Types.h>
+#include <Dcc/Packet.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// State of multi function decoders (locomotives) decoded from multi function packets.
+  ///
+  /// The table has a fixed capacity and uses open addressing with linear probing: an address is
+  /// hashed to a slot; if the slot holds another address, the next slots are probed. Lookup and
+  /// update take O(1) probes as long as the table is not too full (keep the number of addresses
+  /// below 3/4 of Capacity). Entries are not removed (see clear()). If the table is full, packets
+  /// for new addresses are dropped and counted (see get_overflow_count()).
+  ///
+  /// Decoded instructions [S-9.2.1]:
+  /// - 010DDDDD / 011DDDDD: speed and direction with 28 speed steps (CV29 bit 1 = 1)
+  /// - 00111111 DSSSSSSS: speed and direction with 126 speed steps
+  /// - 100DDDDD: F0 - F4, 1011DDDD: F5 - F8, 1010DDDD: F9 - F12
+  /// - 11011110 DDDDDDDD: F13 - F20, 11011111 DDDDDDDD: F21 - F28
+  ///
+  /// An entry that changes is marked dirty and appended to a list of dirty entries, so the main
+  /// loop processes changed entries with pop_dirty() without scanning the table. Repetitions of
+  /// the same packet do not mark an entry dirty. Broadcast packets (address 0) are ignored.
+  ///
+  /// RAM: 10 bytes per entry (8 bytes entry + 2 bytes dirty list).
+  ///
+  /// @tparam Packet   Type of DCC packet such as dcc::packet<6>
+  /// @tparam Capacity Maximal number of addresses, a power of 2
+  // ---------------------------------------------------------------------
+  template<class Packet, uint16 Capacity = 256U>
+  class loco_table
+  {
+  public:
+    static_assert((Capacity > 0U) && ((Capacity & (Capacity - 1U)) == 0U), "loco_table: Capacity must be a power of 2");
+
+    using packet_type = Packet;
+    using address_type = typename packet_type::address_type;
+
+    /// Maximal number of addresses
+    static constexpr uint16 kCapacity = Capacity;
+    /// Address of an empty slot
+    static constexpr address_type kEmpty = packet_type::kInvalidAddress;
+    /// Speed value of an emergency stop
+    static constexpr uint8 kEmergencyStop = 0xFFU;
+
+    /// Bits of entry_type::flags
+    static constexpr uint8 kFlagForward = 0x01U; ///< Direction forward
+    static constexpr uint8 kFlagSpeed28 = 0x02U; ///< Last speed was sent with 28 speed steps (else 126 speed steps)
+    static constexpr uint8 kFlagDirty = 0x04U;   ///< Changed since the entry was returned by pop_dirty()
+
+    /// State of a multi function decoder
+    struct entry_type
+    {
+      /// Address (1 - 127: 7 bit address, 0 - 10239: 14 bit address); kEmpty if the slot is empty
+      address_type address;
+      /// Speed step: 0 = stop, 1 - 126 (or 1 - 28, see kFlagSpeed28), kEmergencyStop
+      uint8 speed;
+      /// kFlagForward, kFlagSpeed28, kFlagDirty
+      uint8 flags;
+      /// Bit i is the state of function Fi (F0 - F28)
+      uint32 functions;
+
+      /// Returns true if the direction is forward
+      bool is_forward() const noexcept { return (flags & kFlagForward) != 0U; }
+      /// Returns true if the last speed was sent with 28 speed steps
+      bool is_speed28() const noexcept { return (flags & kFlagSpeed28) != 0U; }
+      /// Returns the state of function Fi (i in [0, 28])
+      bool get_function(uint8 i) const noexcept { return ((functions >> i) & 1U) != 0U; }
+    };
+
+  protected:
+    /// Returns log2 of x
+    static constexpr uint8 log2(uint32 x) noexcept { return (x > 1U) ? static_cast<uint8>(1U + log2(x >> 1U)) : 0U; }
+    static constexpr uint8 kHashShift = static_cast<uint8>(16U - log2(Capacity));
+    static constexpr uint16 kMask = static_cast<uint16>(Capacity - 1U);
+
+    /// The slots
+    entry_type entries[Capacity];
+    /// Ring of the indices of dirty entries in the order of their changes. An entry is in the
+    /// ring at most once (see kFlagDirty), so the ring does not overflow.
+    uint16 dirty[Capacity];
+    /// Position of the next dirty entry in dirty[] (see pop_dirty())
+    uint16 dirty_head;
+    /// Number of dirty entries
+    uint16 nr_dirty;
+    /// Number of used slots
+    uint16 nr_entries;
+    /// Number of packets dropped because the table was full. Can overflow.
+    uint16 overflow_count;
+
+    /// Returns the first slot for address a (Fibonacci hashing, 16 bit)
+    static uint16 hash(address_type a) noexcept
+    {
+      return static_cast<uint16>(static_cast<uint16>(static_cast<uint32>(a) * 40503U) >> kHashShift) & kMask;
+    }
+
+    /// Returns the slot of address a, inserts a if it is not in the table. Returns nullptr if the
+    /// table is full.
+    entry_type* find_or_insert(address_type a) noexcept
+    {
+      uint16 i = hash(a);
+      for (uint16 n = 0U; n < Capacity; n++)
+      {
+        entry_type& e = entries[i];
+        if (e.address == a)
+        {
+          return &e;
+        }
+        if (e.address == kEmpty)
+        {
+          e.address = a;
+          nr_entries++;
+          return &e;
+        }
+        i = static_cast<uint16>((i + 1U) & kMask);
+      }
+      overflow_count++;
+      return nullptr;
+    }
+
+    /// Mark entry e dirty and append it to the list of dirty entries
+    void set_dirty(entry_type& e) noexcept
+    {
+      if ((e.flags & kFlagDirty) == 0U)
+      {
+        e.flags |= kFlagDirty;
+        dirty[(dirty_head + nr_dirty) & kMask] = static_cast<uint16>(&e - entries);
+        nr_dirty++;
+      }
+    }
+
+    /// Set speed, direction and speed step mode of entry e
+    static void set_speed(entry_type& e, uint8 speed, bool forward, bool speed28) noexcept
+    {
+      e.speed = speed;
+      e.flags = static_cast<uint8>((e.flags & kFlagDirty) | (forward ? kFlagForward : 0U) | (speed28 ? kFlagSpeed28 : 0U));
+    }
+
+    /// Set the functions selected by mask to the bits of value
+    static void set_functions(entry_type& e, uint32 mask, uint32 value) noexcept
+    {
+      e.functions = (e.functions & ~mask) | (value & mask);
+    }
+
+  public:
+    /// Construct an empty table
+    loco_table() noexcept { clear(); }
+
+    /// Remove all entries
+    void clear() noexcept
+    {
+      for (uint16 i = 0U; i < Capacity; i++)
+      {
+        entries[i] = entry_type{ kEmpty, 0U, 0U, 0U };
+      }
+      dirty_head = 0U;
+      nr_dirty = 0U;
+      nr_entries = 0U;
+      overflow_count = 0U;
+    }
+
+    /**
+     * @brief Decode a multi function packet and update the entry of its address.
+     *
+     * @param pkt The packet. Not const because the packet caches its type and address.
+     * @return true if the packet carries a decoded instruction (see class description)
+     */
+    bool update(packet_type& pkt) noexcept
+    {
+      size_t idx;
+      switch (pkt.get_type())
+      {
+        case packet_type::packet_type::MultiFunction7:
+          idx = 1U;
+          break;
+        case packet_type::packet_type::MultiFunction14:
+          idx = 2U;
+          break;
+        default:
+          return false;
+      }
+      // number of bytes without checksum
+      const size_t n = pkt.getNrBytes() - 1U;
+      if (idx >= n)
+      {
+        return false;
+      }
+      const uint8 instr = pkt.refByte(idx);
+      const bool has_data = (idx + 1U < n);
+      const uint8 data = has_data ? pkt.refByte(idx + 1U) : 0U;
+      const uint8 group = static_cast<uint8>(instr >> 5U);
+      if (!((group == 0b010U) || (group == 0b011U) || (group == 0b100U) || (group == 0b101U) ||
+            ((instr == 0x3FU) && has_data) || (((instr == 0xDEU) || (instr == 0xDFU)) && has_data)))
+      {
+        return false;
+      }
+
+      entry_type* e = find_or_insert(pkt.get_address(0U));
+      if (e == nullptr)
+      {
+        return true;
+      }
+      const entry_type old = *e;
+      switch (group)
+      {
+        case 0b001U:
+        {
+          // 00111111 DSSSSSSS: 0 = stop, 1 = emergency stop, 2 - 127 = speed step 1 - 126
+          const uint8 s = static_cast<uint8>(data & 0x7FU);
+          set_speed(*e, (s == 0U) ? 0U : ((s == 1U) ? kEmergencyStop : static_cast<uint8>(s - 1U)), (data & 0x80U) != 0U, false);
+          break;
+        }
+        case 0b010U:
+        case 0b011U:
+        {
+          // 01DCSSSS: speed CSSSS (C is the least significant bit), 0 - 1 = stop,
+          // 2 - 3 = emergency stop, 4 - 31 = speed step 1 - 28
+          const uint8 s = static_cast<uint8>(((instr & 0x0FU) << 1U) | ((instr >> 4U) & 0x01U));
+          set_speed(*e, (s <= 1U) ? 0U : ((s <= 3U) ? kEmergencyStop : static_cast<uint8>(s - 3U)), group == 0b011U, true);
+          break;
+        }
+        case 0b100U:
+          // 100DDDDD: F0 is bit 4, F1 - F4 are bits 0 - 3
+          set_functions(*e, 0x1FUL, (static_cast<uint32>(instr & 0x0FU) << 1U) | ((instr >> 4U) & 0x01U));
+          break;
+        case 0b101U:
+          if ((instr & 0x10U) != 0U)
+          {
+            // 1011DDDD: F5 - F8
+            set_functions(*e, 0x0FUL << 5U, static_cast<uint32>(instr & 0x0FU) << 5U);
+          }
+          else
+          {
+            // 1010DDDD: F9 - F12
+            set_functions(*e, 0x0FUL << 9U, static_cast<uint32>(instr & 0x0FU) << 9U);
+          }
+          break;
+        default:
+          // 11011110 DDDDDDDD: F13 - F20, 11011111 DDDDDDDD: F21 - F28
+          set_functions(*e, 0xFFUL << ((instr == 0xDEU) ? 13U : 21U), static_cast<uint32>(data) << ((instr == 0xDEU) ? 13U : 21U));
+          break;
+      }
+      if ((e->speed != old.speed) || (e->flags != old.flags) || (e->functions != old.functions) || (old.address == kEmpty))
+      {
+        set_dirty(*e);
+      }
+      return true;
+    }
+
+    /**
+     * @brief Returns the entry of an address.
+     *
+     * @param a The address
+     * @return Pointer to the entry or nullptr if the address is not in the table
+     */
+    const entry_type* find(address_type a) const noexcept
+    {
+      uint16 i = hash(a);
+      for (uint16 n = 0U; n < Capacity; n++)
+      {
+        const entry_type& e = entries[i];
+        if (e.address == a)
+        {
+          return &e;
+        }
+        if (e.address == kEmpty)
+        {
+          break;
+        }
+        i = static_cast<uint16>((i + 1U) & kMask);
+      }
+      return nullptr;
+    }
+
+    /**
+     * @brief Returns the next dirty entry and clears its dirty flag. Entries are returned in the
+     * order of their first change.
+     *
+     * @return Pointer to the entry or nullptr if there is no dirty entry
+     */
+    const entry_type* pop_dirty() noexcept
+    {
+      if (nr_dirty == 0U)
+      {
+        return nullptr;
+      }
+      entry_type& e = entries[dirty[dirty_head]];
+      dirty_head = static_cast<uint16>((dirty_head + 1U) & kMask);
+      nr_dirty--;
+      e.flags = static_cast<uint8>(e.flags & ~kFlagDirty);
+      return &e;
+    }
+
+    /// Returns the number of dirty entries
+    uint16 get_nr_dirty() const noexcept { return nr_dirty; }
+    /// Returns the number of addresses in the table
+    uint16 size() const noexcept { return nr_entries; }
+    /// Returns the number of packets dropped because the table was full. Can overflow.
+    uint16 get_overflow_count() const noexcept { return overflow_count; }
+  };
+} // namespace dcc
+
+#endif // DCC_LOCOTABLE_H
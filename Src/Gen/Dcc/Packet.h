@@ -22,6 +22,7 @@
 #define DCC_PACKET_H
 
 #include <Std_Types.h>
+#include <Dcc/DecoderCfg.h>
 #include <Util/Math.h>
 #include <Util/Array.h>
 #include <Util/bitset.h>
@@ -129,6 +130,16 @@ namespace dcc
         /// byte array
         byte_array_type bytes;
 
+        /// Checksum state as known from reception; see set_checksum_ok()
+        enum class checksum_state : uint8
+        {
+            Unknown,    /**< Not known yet, is calculated with testChecksum() */
+            Ok,         /**< Checksum is correct */
+            Bad         /**< Checksum is not correct */
+        };
+        /// Checksum state
+        checksum_state checksum;
+
         /// Return current byte index (index into array of bytes)
         uint16 byteIdx() const noexcept { return static_cast<uint16>(ucNrNbits / 8u); }
         /// Return current bit index (in current byte byteIdx())
@@ -191,7 +202,7 @@ namespace dcc
                 // continue with non-idle packets. These packets must have three bytes at least.
                 else if (getNrBytes() > 2)
                 {
-                    if (testChecksum())
+                    if (is_checksum_ok())
                     {
                         type = decodeMultiFunctionOrAccessory();
                     }
@@ -305,37 +316,10 @@ namespace dcc
                     address = 255;
                     break;
                 case packet_type::BasicAccessory:
-                    // {preamble} 0 10AAAAAA 0 1ĀĀĀCDDD 0 EEEEEEEE 1 [S-9.2.1 2012]
-                    // {preamble} 0 10AAAAAA 0 1ĀĀĀDAAR 0 EEEEEEEE 1 [S-9.2.1 2025]
-                    // Decoder address method
-                    address = static_cast<address_type>(
-                        (util::bits::apply_mask_as<uint8, address_type>(refByte(0), 0b00111111U)) |
-                        (util::bits::apply_mask_as<uint8, address_type>(~refByte(1), 0b01110000U) << 2U));
-                    if (cv29 & cfg::kBitMask_Cv29_OutputAddressMethod)
-                    {
-                        // Output address method
-                        // Two possible ways to calculate:
-                        // addr--; addr = addr << 2 | output_pair; addr++;
-                        //         addr = addr << 2 | output_pair; addr -= 3;
-                        address = static_cast<address_type>(
-                            (address << 2U) | 
-                            (util::bits::apply_mask_as<uint8, address_type>(refByte(1), 0b00000110U) >> 1U));
-                        if (address > 3)
-                        {
-                            address -= 3; // 1 .. 2044
-                        }
-                        else
-                        {
-                            address += 2045; // 2045 .. 2048
-                        }
-                    }
+                    address = basic_accessory_address(refByte(0), refByte(1), cv29);
                     break;
                 case packet_type::ExtendedAccessory:
-                    // {preamble} 0 10AAAAAA 0 0AAA0AA1 0 000XXXXX 0 EEEEEEEE 1
-                    address = static_cast<uint16>(
-                        (util::bits::apply_mask_as<uint8, uint16>(refByte(0), 0b00111111U)) |
-                        (util::bits::apply_mask_as<uint8, uint16>(refByte(1), 0b01110000U) << 4U) |
-                        (util::bits::apply_mask_as<uint8, uint16>(refByte(1), 0b00000110U) << 5U));
+                    address = extended_accessory_address(refByte(0), refByte(1));
                     break;
                 case packet_type::Init:
                 case packet_type::Unknown:
@@ -353,6 +337,67 @@ namespace dcc
         /// number of "1" in the preamble
         uint8 preamble_one_count;
 
+        #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+        /// [us] hal::micros() when the end bit of the packet was received; 0 if unknown
+        uint32 timestamp_us;
+        /// Set the time stamp [us], see CFG_DCC_DECODER_TIMESTAMP
+        void set_timestamp(uint32 t_us) noexcept { timestamp_us = t_us; }
+        /// Returns the time stamp [us], see CFG_DCC_DECODER_TIMESTAMP
+        uint32 get_timestamp() const noexcept { return timestamp_us; }
+        #endif
+
+        /**
+         * @brief Returns the address of a basic accessory packet from its first two bytes.
+         * 
+         * @param byte0 First byte of the packet
+         * @param byte1 Second byte of the packet
+         * @param cv29 The value of CV29. Selects decoder address method (9 bit) or output address
+         * method (11 bit, 1 - 2048).
+         */
+        static address_type basic_accessory_address(uint8 byte0, uint8 byte1, uint8 cv29) noexcept
+        {
+            // {preamble} 0 10AAAAAA 0 1ĀĀĀCDDD 0 EEEEEEEE 1 [S-9.2.1 2012]
+            // {preamble} 0 10AAAAAA 0 1ĀĀĀDAAR 0 EEEEEEEE 1 [S-9.2.1 2025]
+            // Decoder address method
+            address_type address = static_cast<address_type>(
+                (util::bits::apply_mask_as<uint8, address_type>(byte0, 0b00111111U)) |
+                (util::bits::apply_mask_as<uint8, address_type>(static_cast<uint8>(~byte1), 0b01110000U) << 2U));
+            if (cv29 & cfg::kBitMask_Cv29_OutputAddressMethod)
+            {
+                // Output address method
+                // Two possible ways to calculate:
+                // addr--; addr = addr << 2 | output_pair; addr++;
+                //         addr = addr << 2 | output_pair; addr -= 3;
+                address = static_cast<address_type>(
+                    (address << 2U) | 
+                    (util::bits::apply_mask_as<uint8, address_type>(byte1, 0b00000110U) >> 1U));
+                if (address > 3)
+                {
+                    address -= 3; // 1 .. 2044
+                }
+                else
+                {
+                    address += 2045; // 2045 .. 2048
+                }
+            }
+            return address;
+        }
+
+        /**
+         * @brief Returns the address of an extended accessory packet from its first two bytes.
+         * 
+         * @param byte0 First byte of the packet
+         * @param byte1 Second byte of the packet
+         */
+        static address_type extended_accessory_address(uint8 byte0, uint8 byte1) noexcept
+        {
+            // {preamble} 0 10AAAAAA 0 0AAA0AA1 0 000XXXXX 0 EEEEEEEE 1
+            return static_cast<address_type>(
+                (util::bits::apply_mask_as<uint8, address_type>(byte0, 0b00111111U)) |
+                (util::bits::apply_mask_as<uint8, address_type>(byte1, 0b01110000U) << 4U) |
+                (util::bits::apply_mask_as<uint8, address_type>(byte1, 0b00000110U) << 5U));
+        }
+
         /// Constructor
         packet() { clear(); }
         /**
@@ -365,14 +410,14 @@ namespace dcc
          * @param num_bytes Number of bytes in the data.
          */
         packet(const uint8 *data, uint8_least num_bytes)
-            : ucNrNbits{0}, bytes{}, decoded_data{ kInvalidAddress, packet_type::Init }, preamble_one_count{0}
+            : ucNrNbits{0}, bytes{}, checksum{checksum_state::Unknown}, decoded_data{ kInvalidAddress, packet_type::Init }, preamble_one_count{0}
+        #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+            , timestamp_us{0}
+        #endif
         {
             for (uint8_least i = 0; i < num_bytes; i++)
             {
-                for (sint8_fast bit = 7; bit >= 0; bit--)
-                {
-                    addBit((data[i] >> bit) & 0x01U);
-                }
+                (void) add_byte(data[i]);
             }
         }
         /// clear all decoded_data
@@ -380,15 +425,64 @@ namespace dcc
         {
             ucNrNbits = 0;
             bytes.fill(0);
+            checksum = checksum_state::Unknown;
             decoded_data.type = packet_type::Init;
             decoded_data.address = kInvalidAddress;
             preamble_one_count = 0;
+            #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+            timestamp_us = 0;
+            #endif
         }
         /// add a bit (0 or 1)
         void addBit(uint8 uc_bit)
         {
             refByte(byteIdx()) = static_cast<uint8>((refByte(byteIdx()) << 1u) | uc_bit);
             ucNrNbits++;
+            checksum = checksum_state::Unknown;
+        }
+
+        /**
+         * @brief Append a complete byte.
+         * 
+         * Precondition: bitIdx() == 0 (only complete bytes were added before)
+         * 
+         * @param b The byte
+         * @return true if the byte was added, false if the packet is full (kMaxBytes)
+         */
+        bool add_byte(uint8 b) noexcept
+        {
+            const uint16 idx = byteIdx();
+            if (idx >= static_cast<uint16>(kMaxBytes))
+            {
+                return false;
+            }
+            bytes[idx] = b;
+            ucNrNbits = static_cast<uint8_least>(ucNrNbits + 8u);
+            checksum = checksum_state::Unknown;
+            return true;
+        }
+
+        /**
+         * @brief Set the checksum state, e.g. from a running XOR during reception. Saves a 
+         * walk through the packet in testChecksum() during decode().
+         * 
+         * @param ok true if the checksum is correct
+         */
+        void set_checksum_ok(bool ok) noexcept { checksum = ok ? checksum_state::Ok : checksum_state::Bad; }
+
+        /**
+         * @brief Returns true if the checksum is correct. Uses the state from set_checksum_ok()
+         * if available; calls testChecksum() otherwise.
+         * 
+         * Precondition: getNrBytes() > 0
+         */
+        bool is_checksum_ok()
+        {
+            if (checksum == checksum_state::Unknown)
+            {
+                set_checksum_ok(testChecksum());
+            }
+            return checksum == checksum_state::Ok;
         }
 
         /// Returns a reference to the byte at specified location idx. No bounds checking is performed.
@@ -595,6 +689,62 @@ namespace dcc
         /**
          * @}
          */
+
+        /**
+         * @defgroup Get functions for CV access (programming)
+         * @{
+         */
+        /// CC bits of a CV access instruction (1110CCVV, 0111CCVV)
+        static constexpr uint8 kCvVerifyByte = 0b01U;      ///< Verify byte
+        static constexpr uint8 kCvBitManipulation = 0b10U; ///< Bit manipulation (data 111KDBBB)
+        static constexpr uint8 kCvWriteByte = 0b11U;       ///< Write byte
+
+        /**
+         * @brief Returns true if the packet carries a CV access instruction for operations mode
+         * programming of accessory decoders [S-9.2.1]:
+         * `{preamble} 0 10AAAAAA 0 1AAACDDD 0 1110CCVV 0 VVVVVVVV 0 DDDDDDDD 0 EEEEEEEE 1` (basic) or
+         * `{preamble} 0 10AAAAAA 0 0AAA0AA1 0 1110CCVV 0 VVVVVVVV 0 DDDDDDDD 0 EEEEEEEE 1` (extended).
+         *
+         * @note Not const because the packet type is cached.
+         */
+        bool is_ops_mode_cv_access()
+        {
+            const packet_type t = get_type();
+            return ((t == packet_type::BasicAccessory) || (t == packet_type::ExtendedAccessory)) &&
+                   (getNrBytes() == 6U) && ((refByte(2) & 0xF0U) == 0xE0U);
+        }
+
+        /**
+         * @brief Returns true if the packet has the format of a service mode instruction, direct
+         * mode [S-9.2.3]: `{preamble} 0 0111CCVV 0 VVVVVVVV 0 DDDDDDDD 0 EEEEEEEE 1`.
+         *
+         * On the main track, such a packet is a multi function packet for addresses 112 - 127;
+         * the decoder decides from its state (service mode after reset packets).
+         *
+         * @note Not const because the packet type is cached.
+         */
+        bool is_service_mode()
+        {
+            return (get_type() == packet_type::MultiFunction7) && (getNrBytes() == 4U) && ((refByte(0) & 0xF0U) == 0x70U);
+        }
+
+        /// Returns true if the packet carries a CV access instruction in operations mode or in
+        /// service mode (see is_ops_mode_cv_access() and is_service_mode())
+        bool is_cv_access() { return is_ops_mode_cv_access() || is_service_mode(); }
+
+        /**
+         * @brief Returns the index of the CV access instruction byte (1110CCVV, 0111CCVV): 0 in
+         * service mode, 2 in operations mode. Only valid if is_cv_access() returns true.
+         *
+         * @note Not const because the packet type is cached.
+         */
+        uint8 get_cv_access_index() { return is_service_mode() ? 0U : 2U; }
+
+        /// Returns true if the packet is a digital decoder reset packet `00000000 0 00000000 0 00000000`
+        bool is_reset() { return (get_type() == packet_type::MultiFunctionBroadcast) && (getNrBytes() == 3U) && (refByte(1) == 0U); }
+        /**
+         * @}
+         */
     };
 
 } // namespace dcc
@@ -14,9 +14,57 @@
 #include <Std_Types.h>
 #include <Dcc/Packet.h>
 #include <Dcc/DecoderCfg.h>
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+#include <Hal/Timer.h>
+#endif
 
 namespace dcc
 {
+  // ---------------------------------------------------
+  /**
+   * @brief Interface for a handler with virtual functions. Such a handler is called when a new 
+   * packet is available.
+   * 
+   * This is the runtime-polymorphic adapter for packet_extractor: derive from this class if the 
+   * handler is selected at run time. Handlers that are known at compile time do not need to 
+   * derive from this class; they provide the same functions (non-virtual) and are passed as 
+   * template parameter Handler of packet_extractor so that the calls are inlined.
+   * 
+   * @tparam Packet The packet type
+   */
+  // ---------------------------------------------------
+  template<class Packet = packet<> >
+  class packet_handler_ifc
+  {
+  public:
+    /// The packets
+    using packet_type = Packet;
+    /// Construct and destruct
+    packet_handler_ifc() {}
+
+    /// Do not define (virtual) destructors
+    /// - Nothing to be deleted since dynamic memory allocation is not used
+    ///   and objects are destructed at shut down only (-> never).
+    /// - When using virtual destructors, AVR GCC throws 'undefined reference 
+    ///   to `operator delete(void*, unsigned int)'.
+
+    /// If a new packet is available, this function is called
+    /// The parameter pkt is not const to enable the handler to
+    /// modify the received packet, e.g. to call decode() for
+    /// address calculation.
+    virtual void packet_received(packet_type& pkt) = 0;
+
+    /// Returns a free packet slot in which the next packet is assembled, or nullptr to 
+    /// assemble it in the extractor's own packet. Called after a valid preamble. The slot
+    /// is handed back with packet_received() (or dropped if the packet is incomplete).
+    /// Storing the slot avoids copying the packet in packet_received().
+    virtual packet_type* get_packet_slot() { return nullptr; }
+
+    /// Returns false if packets with first byte byte0 (the primary address) shall be skipped.
+    /// Called after the first byte of a packet if early reject is enabled (see packet_extractor).
+    virtual bool accept_first_byte(uint8 byte0) { (void) byte0; return true; }
+  };
+
   // ---------------------------------------------------
   /**
    * @brief Extract DCC packets from a bit stream.
@@ -67,38 +115,35 @@ namespace dcc
    * - Broadcast packets (e.g., emergency stop): shorter
    * - Long packets (e.g., CV programming): longer
    * 
+   * The handler is bound at compile time (template parameter Handler). It must provide the 
+   * public member functions
+   * - void packet_received(packet_type& pkt): called if a new packet is available
+   * - packet_type* get_packet_slot(): returns a free packet slot or nullptr (see packet_handler_ifc)
+   * - bool accept_first_byte(uint8 byte0): only if EarlyReject is true (see packet_handler_ifc)
+   * 
+   * With the default handler_ifc, the functions are virtual and the handler is selected at run time.
+   * 
+   * Early reject: most packets on a layout are for other decoders. If EarlyReject is true, the
+   * handler is asked after the first byte. If it rejects the byte, the remaining bits of the packet
+   * are counted only (state SKIP): no bytes are stored, no checksum is calculated and the handler
+   * is not called until the next packet.
+   * 
    * @tparam PreambleMinNrOnes Minimum number of "1" bits in the preamble to consider it valid (default: 10).
+   * @tparam Handler The handler type, such as dcc::decoder (default: handler_ifc with virtual functions).
+   * @tparam EarlyReject If true, the handler can reject packets after their first byte (default: false).
    */
-  template<int PreambleMinNrOnes = 10>
+  template<int PreambleMinNrOnes = 10, class Handler = packet_handler_ifc<>, bool EarlyReject = false>
   class packet_extractor
   {
   public:
     /// This class
-    using this_class = packet_extractor<PreambleMinNrOnes>;
+    using this_class = packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>;
     /// The Packet type
     using packet_type = packet<>;
-
-    /// Interface for a handler. Such a handler is called when a new packet is available
-    class handler_ifc
-    {
-    public:
-      /// The packets
-      using packet_type = this_class::packet_type;
-      /// Construct and destruct
-      handler_ifc() {}
-
-      /// Do not define (virtual) destructors
-      /// - Nothing to be deleted since dynamic memory allocation is not used
-      ///   and objects are destructed at shut down only (-> never).
-      /// - When using virtual destructors, AVR GCC throws 'undefined reference 
-      ///   to `operator delete(void*, unsigned int)'.
-
-      /// If a new packet is available, this function is called
-      /// The parameter pkt is not const to enable the handler to
-      /// modify the received packet, e.g. to call decode() for
-      /// address calculation.
-      virtual void packet_received(packet_type& pkt) = 0;
-    };
+    /// Interface for a handler with virtual functions (runtime-polymorphic adapter)
+    using handler_ifc = packet_handler_ifc<packet_type>;
+    /// The handler type
+    using handler_type = Handler;
 
   protected:
     /// Interpretation state
@@ -106,7 +151,8 @@ namespace dcc
     {
       PREAMBLE  = 0,   ///< Receiving preamble
       DATA      = 1,   ///< Receiving adress or data bytes
-      MAX_COUNT = 2
+      SKIP      = 2,   ///< Counting the bits of a rejected packet until its end bit
+      MAX_COUNT = 3
     };
 
     /// Bit "0" or Bit "1" bit received
@@ -131,38 +177,63 @@ namespace dcc
     eState execute_preamble(eBit bitRcv);
     /// State machine handle function for STATE_DATA 
     eState execute_data(eBit bitRcv);
+    /// State machine handle function for STATE_SKIP 
+    eState execute_skip(eBit bitRcv);
+
+    /// Selects is_rejected() at compile time so that handlers without accept_first_byte() compile
+    template<bool Enable> struct early_reject_tag {};
+    /// Returns true if the handler rejects the first byte of the packet
+    bool is_rejected(uint8 byte, early_reject_tag<true>)
+    {
+      return (active_packet->getNrBytes() == 0u) && !handler.accept_first_byte(byte);
+    }
+    /// Early reject is disabled
+    bool is_rejected(uint8, early_reject_tag<false>) { return false; }
 
     /// Number of "1" received
     uint8_least preamble_one_count;
     /// Count received data bits for current packet per byte: first 8 bits are stored in a packet, 9th bit defines "packet finished" (1 bit) or "more bytes" (0 bit)
     /// Counts from 0 (nothing received yet) up to 9 (trailing 0 bit)
     uint8_least data_bits_count;
+    /// The data bits of the current byte; the byte is added to the packet with the 9th bit
+    uint8 data_byte;
+    /// XOR of all bytes of the current packet including the checksum byte; 0 for a correct checksum
+    uint8 checksum_xor;
 
-    /// Reference for handler_ifc interface. This interface is called as soon as a new packet is available.
-    handler_ifc& handler;
+    /// Reference to the handler. The handler is called as soon as a new packet is available.
+    handler_type& handler;
 
-    /// Packet that is processed (received) currently
+    /// Own packet; used if the handler does not provide a packet slot
     packet_type current_packet;
 
+    /// Packet that is processed (received) currently: a slot of the handler or current_packet
+    packet_type *active_packet;
+
   public:
     #if CFG_DCC_DECODER_DEBUG == OPT_DCC_DECODER_DEBUG_ON
     uint32 ones_count;
     uint32 zeros_count;
     uint32 invalids_count;
+    uint32 checksum_errors_count;
     void inc_ones() { ones_count++; }
     void inc_zeros() { zeros_count++; }
     void inc_invalids() { invalids_count++; }
+    void inc_checksum_errors() { checksum_errors_count++; }
     #else
     void inc_ones() {}
     void inc_zeros() {}
     void inc_invalids() {}
+    void inc_checksum_errors() {}
     #endif
 
     /// constructor
-    packet_extractor(handler_ifc& hifc)
+    packet_extractor(handler_type& hifc)
       : state(eState::PREAMBLE)
       , data_bits_count(0u)
+      , data_byte(0u)
+      , checksum_xor(0u)
       , handler(hifc)
+      , active_packet(&current_packet)
     {
       invalid();
     }
@@ -180,7 +251,6 @@ namespace dcc
       state = eState::PREAMBLE;
       preamble_one_count = 0u;
       data_bits_count = 0u;
-      current_packet.clear();
     }
   };
 
@@ -188,8 +258,8 @@ namespace dcc
   /// State function: check if a valid preamble is transmitted:
   /// Sequence of at least 10x "1", followed by a "0" 
   // ---------------------------------------------------
-  template<int PreambleMinNrOnes>
-  typename packet_extractor<PreambleMinNrOnes>::eState packet_extractor<PreambleMinNrOnes>::execute_preamble(eBit bitRcv)
+  template<int PreambleMinNrOnes, class Handler, bool EarlyReject>
+  typename packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::eState packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::execute_preamble(eBit bitRcv)
   {
     eState nextState = state;
 
@@ -206,10 +276,19 @@ namespace dcc
       if (is_preamble_valid(preamble_one_count))
       {
         nextState = eState::DATA;
+
+        // borrow a slot from the handler to assemble the packet in place
+        active_packet = handler.get_packet_slot();
+        if (active_packet == nullptr)
+        {
+          active_packet = &current_packet;
+        }
+        active_packet->clear();
+        // store number of preamble "1" in the packet
+        active_packet->preamble_one_count = preamble_one_count;
+        checksum_xor = 0u;
       }
 
-      // store number of preamble "1" in the packet; can be optimized (use current_packet.preamble_one_count instead of preamble_one_count)
-      current_packet.preamble_one_count = preamble_one_count;
       // reset counter because
       // - min number of "1" not reached, invalid or waiting for first "1"
       // - or valid preamble detected, switch to STATE_DATA but prepare next switch to STATE_PREAMBLE
@@ -222,29 +301,82 @@ namespace dcc
   // ---------------------------------------------------
   /// State function: Interpret adress or data bytes bit by bit.
   // ---------------------------------------------------
-  template<int PreambleMinNrOnes>
-  typename packet_extractor<PreambleMinNrOnes>::eState packet_extractor<PreambleMinNrOnes>::execute_data(eBit bitRcv)
+  template<int PreambleMinNrOnes, class Handler, bool EarlyReject>
+  typename packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::eState packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::execute_data(eBit bitRcv)
   {
     eState next_state = state;
 
     if (data_bits_count < 8u)
     {
-      current_packet.addBit(static_cast<uint8>(bitRcv));
+      // shift into a register; the packet is written once per byte
+      data_byte = static_cast<uint8>((data_byte << 1u) | static_cast<uint8>(bitRcv));
       data_bits_count++;
     }
     else
     {
       data_bits_count = 0u;
 
-      // Bit 0 is expected at the end of a data / address byte
-      // If a 1 bit is received instead of a 0 bit, the packet is finished and the next packet is to be received
+      if (is_rejected(data_byte, early_reject_tag<EarlyReject>{}))
+      {
+        // packet for another decoder: count the bits until the end bit
+        next_state = (bitRcv == eBit::ONE) ? eState::PREAMBLE : eState::SKIP;
+      }
+      else if (!active_packet->add_byte(data_byte))
+      {
+        // too many bytes: not a valid packet, wait for the next preamble
+        next_state = eState::PREAMBLE;
+      }
+      else
+      {
+        checksum_xor ^= data_byte;
+
+        // Bit 0 is expected at the end of a data / address byte
+        // If a 1 bit is received instead of a 0 bit, the packet is finished and the next packet is to be received
+        if (bitRcv == eBit::ONE)
+        {
+          next_state = eState::PREAMBLE;
+          active_packet->set_checksum_ok(checksum_xor == 0u);
+          #if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+          active_packet->set_timestamp(hal::micros());
+          #endif
+          if (checksum_xor != 0u)
+          {
+            inc_checksum_errors();
+          }
+          #if CFG_DCC_DECODER_REJECT_BAD_CHECKSUM == OPT_DCC_DECODER_REJECT_BAD_CHECKSUM_ON
+          // corrupt packets do not take FIFO space
+          if (checksum_xor == 0u)
+          #endif
+          {
+            // notify handler about new packet; the next packet is cleared after its preamble
+            handler.packet_received(*active_packet);
+          }
+        }
+      }
+    }
+
+    return next_state;
+  }
+
+  // ---------------------------------------------------
+  /// State function: Count the bits of a rejected packet. The 9th bit of each byte is the end bit
+  /// (1) or the start bit of the next byte (0).
+  // ---------------------------------------------------
+  template<int PreambleMinNrOnes, class Handler, bool EarlyReject>
+  typename packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::eState packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::execute_skip(eBit bitRcv)
+  {
+    eState next_state = state;
+
+    if (data_bits_count < 8u)
+    {
+      data_bits_count++;
+    }
+    else
+    {
+      data_bits_count = 0u;
       if (bitRcv == eBit::ONE)
       {
         next_state = eState::PREAMBLE;
-        // notify handler about new packet
-        handler.packet_received(current_packet);
-        // prepare next reception
-        current_packet.clear();
       }
     }
 
@@ -254,13 +386,14 @@ namespace dcc
   // ---------------------------------------------------
   /// trigger state machine
   // ---------------------------------------------------
-  template<int PreambleMinNrOnes>
-  void packet_extractor<PreambleMinNrOnes>::execute(eBit bit_rcv)
+  template<int PreambleMinNrOnes, class Handler, bool EarlyReject>
+  void packet_extractor<PreambleMinNrOnes, Handler, EarlyReject>::execute(eBit bit_rcv)
   {
     switch (state)
     {
     case eState::PREAMBLE: { state = execute_preamble(bit_rcv); } break;
     case eState::DATA: { state = execute_data(bit_rcv); } break;
+    case eState::SKIP: { state = execute_skip(bit_rcv); } break;
     default: {} break;
     }
   }
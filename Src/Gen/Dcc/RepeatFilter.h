@@ -0,0 +1,266 @@
+/**
+ * @file RepeatFilter.h
+ * @author Ralf Sondershaus
+ *
+ * @brief DCC repeat filter
+ *
+ * Declares class dcc::repeat_filter that suppresses repeated DCC packets.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_REPEATFILTER_H
+#define DCC_REPEATFILTER_H
+
+#include <Std_Types.h>
+#include <Dcc/DecoderCfg.h>
+#include <Dcc/Filter.h>
+#include <Hal/Timer.h>
+#include <OS_Type.h> // SuspendAllInterrupts(), ResumeAllInterrupts()
+
+namespace dcc
+{
+    // ---------------------------------------------------------------------
+    /// This filter suppresses packets that were seen within a time window.
+    ///
+    /// Command stations repeat every packet several times and refresh them continuously. The filter
+    /// keeps a small cache of recent packets, keyed by a 16 bit hash of the packet bytes. A packet
+    /// passes if it is not in the cache (miss) or if its entry is older than the window; the entry
+    /// is (re-)started then. Otherwise, the packet is a duplicate (hit) and does not pass.
+    ///
+    /// On a miss, the entry with the same key is replaced, so a command that returns to a previous
+    /// value passes again. If there is no such entry, the oldest entry is replaced. The key of an
+    /// accessory packet is its decoded address including the output pair (basic accessory) or the
+    /// two low address bits (extended accessory), so the outputs of a decoder use separate entries.
+    /// The key of a multi function packet is its decoded address and the group of its first
+    /// instruction (e.g. speed, F0-F4, F5-F8), so the instructions of a loco use separate entries
+    /// as well. The key of other packets is the first byte (the primary address).
+    ///
+    /// The window is started by the packet that passes, not by its repetitions, so a command is
+    /// passed again at least once per window.
+    ///
+    /// CV access instructions and reset packets always pass: a decoder executes a CV access after
+    /// two identical instructions (see dcc::cv_programming), and reset packets keep the decoder in
+    /// service mode.
+    ///
+    /// Times are stored with 16 bits, so an entry that is older than 65.5 s can appear young again.
+    /// Such a hit suppresses a repetition of the last command for that address only.
+    ///
+    /// @note Can be called from an ISR context. The cache is mutable because do_filter() is const.
+    /// clear() only requests to clear the cache, do_filter() clears it, so the cache is not
+    /// modified concurrently if do_filter() runs in the ISR and clear() in the main loop.
+    ///
+    /// @tparam Packet Type of Dcc Packet such as dcc::Packet<6>
+    /// @tparam N      Number of cache entries
+    // ---------------------------------------------------------------------
+    template <class Packet, int N = CFG_DCC_DECODER_REPEAT_FILTER_SIZE>
+    class repeat_filter : public filter<Packet>
+    {
+    public:
+        /// The base class
+        using parent_type = filter<Packet>;
+        /// The type for Dcc Packets
+        using packet_type = typename parent_type::packet_type;
+
+        static_assert((N > 0) && (N <= 255), "repeat_filter: N must be in [1, 255]");
+
+    protected:
+        /// A cache entry
+        struct entry
+        {
+            uint16 hash;     ///< hash of the packet bytes
+            uint16 time_ms;  ///< [ms] lower 16 bits of hal::millis() when the packet passed
+            uint32 key;      ///< decoded address and instruction group of the packet (see calc_key())
+            bool valid;      ///< true if the entry is used
+        };
+
+        /// The cache
+        mutable entry entries[N];
+        /// True if the cache shall be cleared with the next packet (see clear())
+        mutable volatile bool clear_requested;
+        /// [ms] Time window in which repeated packets are suppressed
+        uint16 window_ms;
+        /// Number of suppressed packets. Can overflow. Written by do_filter() (ISR).
+        mutable volatile uint32 hit_count;
+        /// Number of packets that passed. Can overflow. Written by do_filter() (ISR).
+        mutable volatile uint32 miss_count;
+
+    public:
+        /// Construct with time window [ms]
+        repeat_filter(uint16 window = CFG_DCC_DECODER_REPEAT_FILTER_WINDOW_MS) : window_ms(window), hit_count(0), miss_count(0)
+        {
+            clear_entries();
+        }
+
+        /// Remove all entries, e.g. after the address of the decoder has changed. The entries
+        /// are removed by the next call to do_filter(), so clear() can be called while the ISR
+        /// calls do_filter().
+        void clear() noexcept { clear_requested = true; }
+
+        /// Set the time window [ms]
+        void set_window(uint16 window) noexcept { window_ms = window; }
+        /// Get the time window [ms]
+        uint16 get_window() const noexcept { return window_ms; }
+
+        /// Returns the number of suppressed packets (hits). Can overflow. The ISR writes the counter
+        /// with several bytes on 8-bit targets, so it is read with interrupts suspended. Shall be
+        /// called from the main loop.
+        uint32 get_hit_count() const noexcept
+        {
+            SuspendAllInterrupts();
+            const uint32 count = hit_count;
+            ResumeAllInterrupts();
+            return count;
+        }
+        /// Returns the number of passed packets (misses). Can overflow. Read with interrupts
+        /// suspended (see get_hit_count()).
+        uint32 get_miss_count() const noexcept
+        {
+            SuspendAllInterrupts();
+            const uint32 count = miss_count;
+            ResumeAllInterrupts();
+            return count;
+        }
+
+        /// Returns a 16 bit hash of the packet bytes (rotate and XOR)
+        static uint16 calc_hash(const packet_type &pkt) noexcept
+        {
+            uint16 h = static_cast<uint16>(pkt.getNrBytes());
+            for (auto it = pkt.begin(); it != pkt.end_used(); it++)
+            {
+                h = static_cast<uint16>(static_cast<uint16>((h << 5U) | (h >> 11U)) ^ *it);
+            }
+            return h;
+        }
+
+        /**
+         * @brief Returns the group of a multi function instruction byte: the bits that select
+         * the instruction, without its data bits.
+         *
+         * Speed and direction (01DCSSSS): 01000000, function groups one (100DDDDD): 10000000,
+         * function group two (101SDDDD): 101S0000. Other instructions (decoder control, advanced
+         * operations such as 128 speed steps, feature expansion) are distinguished by their
+         * complete first byte.
+         */
+        static uint8 instruction_group(uint8 instr) noexcept
+        {
+            if ((instr & 0xC0U) == 0x40U)
+            {
+                return 0x40U;
+            }
+            if ((instr & 0xE0U) == 0x80U)
+            {
+                return 0x80U;
+            }
+            if ((instr & 0xE0U) == 0xA0U)
+            {
+                return static_cast<uint8>(instr & 0xF0U);
+            }
+            return instr;
+        }
+
+        /**
+         * @brief Returns the key of the cache entry of a packet.
+         *
+         * Accessory packets: 0x8000 0000 | 0000 BAAA AAAA AAPP with B = 1 for basic accessory packets,
+         * the 9 bit address AAAAAAAAA (10AAAAAA 1AAACDDD or 10AAAAAA 0AAA0AA1, high bits in ones
+         * complement) and PP = DD (output pair) or AA (two low address bits).
+         * Multi function packets (broadcast, 7 and 14 bit addresses): 0x40 AAAA GG with the
+         * address AAAA and the instruction group GG (see instruction_group()).
+         * Other packets: the first byte.
+         */
+        static uint32 calc_key(const packet_type &pkt) noexcept
+        {
+            const uint8 byte0 = pkt.refByte(0);
+            const uint8 nr_bytes = static_cast<uint8>(pkt.getNrBytes());
+            if ((nr_bytes > 2U) && ((byte0 & 0xC0U) == 0x80U))
+            {
+                const uint8 byte1 = pkt.refByte(1);
+                return static_cast<uint32>(0x80000000UL | (static_cast<uint32>(byte1 & 0x80U) << 4U) |
+                                           (static_cast<uint32>(~byte1 & 0x70U) << 4U) |
+                                           (static_cast<uint32>(byte0 & 0x3FU) << 2U) |
+                                           ((byte1 >> 1U) & 0x03U));
+            }
+            if ((nr_bytes > 2U) && (byte0 <= packet_type::kPrimaryAddressMultiFunction7_Hi))
+            {
+                return 0x40000000UL | (static_cast<uint32>(byte0) << 8U) | instruction_group(pkt.refByte(1));
+            }
+            if ((nr_bytes > 3U) && (byte0 >= packet_type::kPrimaryAddressMultiFunction14_Lo) &&
+                (byte0 <= packet_type::kPrimaryAddressMultiFunction14_Hi))
+            {
+                const uint32 address = (static_cast<uint32>(byte0 & 0x3FU) << 8U) | pkt.refByte(1);
+                return 0x40000000UL | (address << 8U) | instruction_group(pkt.refByte(2));
+            }
+            return byte0;
+        }
+
+        /// Returns true if the packet passes the filter (miss or expired), false if it is a repetition.
+        bool do_filter(packet_type &pkt) const noexcept override
+        {
+            if (clear_requested)
+            {
+                clear_entries();
+            }
+            if (pkt.is_cv_access() || pkt.is_reset())
+            {
+                return true;
+            }
+            const uint16 now = static_cast<uint16>(hal::millis());
+            const uint16 h = calc_hash(pkt);
+            const uint32 key = calc_key(pkt);
+            int victim = 0;
+            uint16 victim_age = 0;
+            bool victim_same_key = false;
+
+            for (int i = 0; i < N; i++)
+            {
+                entry &e = entries[i];
+                if (!e.valid)
+                {
+                    if (!victim_same_key)
+                    {
+                        victim = i;
+                        victim_age = 0xFFFFU;
+                    }
+                    continue;
+                }
+                const uint16 age = static_cast<uint16>(now - e.time_ms);
+                if (e.key == key)
+                {
+                    if ((e.hash == h) && (age < window_ms))
+                    {
+                        hit_count++;
+                        return false;
+                    }
+                    // same address: the new packet replaces this entry
+                    victim = i;
+                    victim_same_key = true;
+                }
+                else if (!victim_same_key && (age >= victim_age))
+                {
+                    victim = i;
+                    victim_age = age;
+                }
+            }
+
+            entries[victim] = entry{ h, now, key, true };
+            miss_count++;
+            return true;
+        }
+
+    protected:
+        /// Remove all entries. A request that arrives while the entries are removed is kept.
+        void clear_entries() const noexcept
+        {
+            clear_requested = false;
+            for (int i = 0; i < N; i++)
+            {
+                entries[i].valid = false;
+            }
+        }
+    };
+} // namespace dcc
+
+#endif // DCC_REPEATFILTER_H
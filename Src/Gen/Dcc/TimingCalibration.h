@@ -0,0 +1,189 @@
+/**
+ * @file TimingCalibration.h
+ *
+ * @author Ralf Sondershaus
+ *
+ * @brief Provides class dcc::timing_calibration that scales the time deltas between edges so that
+ * a skewed clock or a command station at the edge of the spec fits the windows of dcc::bit_extractor
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DCC_TIMINGCALIBRATION_H
+#define DCC_TIMINGCALIBRATION_H
+
+#include <Std_Types.h>
+#include <Dcc/DecoderCfg.h>
+
+namespace dcc
+{
+  // ---------------------------------------------------------------------
+  /// Adaptive timing calibration in front of the bit extractor.
+  ///
+  /// The thresholds of the bit extractor are compile time constants (see bit_extractor_constants)
+  /// and are folded into its lookup tables: a time delta is classified with two table loads, the
+  /// half bit row (halfbit_row) and then the next state (transition). If the clock of the board
+  /// drifts (e.g. a ceramic resonator) or the command station sends half bits at the edge of the
+  /// spec, the time deltas fall outside the windows and packets are lost.
+  ///
+  /// Instead of moving the thresholds, the calibration scales each time delta with a factor
+  /// (fixed point, 1/256) before it is forwarded, so the lookup tables of the bit extractor are
+  /// kept and the cost per edge is one multiplication. Scaling the time deltas by k is equal to
+  /// shifting the windows by 1/k.
+  ///
+  /// The factor is measured on valid preambles: a run of at least kMinPreamble time deltas within
+  /// the acquisition window of short half bits (nominal 58 us +- MaxSkew percent), ended by the
+  /// first half bit of the packet start bit (a long half bit, 1.4 to 2.2 times the mean short half
+  /// bit). The sum of the mean short and this long half bit is compared to the nominal sum
+  /// 58 us + 100 us, and the factor is moved half the way towards the measured value. The factor
+  /// is limited to MaxSkew percent in both directions. Runs of long half bits (e.g. data bytes
+  /// 0x00) are not taken as preambles because they are not followed by a longer half bit.
+  ///
+  /// Preambles are detected on the unscaled time deltas, so the calibration locks even if the
+  /// bit extractor does not decode any bit with the current factor. The factor is calculated
+  /// once per preamble with multiplications and shifts only.
+  ///
+  /// @tparam TBitExtractor Class that receives time deltas (must provide execute(uint32_t))
+  /// @tparam MaxSkew       [%] Maximal deviation of the clock (or the half bits) from nominal
+  // ---------------------------------------------------------------------
+  template<class TBitExtractor, uint8 MaxSkew = CFG_DCC_DECODER_CALIBRATION_MAX_SKEW>
+  class timing_calibration
+  {
+  public:
+    using bit_extractor_type = TBitExtractor;
+
+    static_assert((MaxSkew > 0U) && (MaxSkew <= 40U), "timing_calibration: MaxSkew shall be in [1, 40] percent");
+
+    /// [%] Maximal deviation of the clock from nominal
+    static constexpr uint8 kMaxSkew = MaxSkew;
+    /// Number of fraction bits of the scale factor
+    static constexpr uint8 kScaleShift = 8U;
+    /// Scale factor 1.0
+    static constexpr uint16 kScaleOne = static_cast<uint16>(1U << kScaleShift);
+    /// Minimal and maximal scale factor (1 / (1 + MaxSkew), 1 / (1 - MaxSkew))
+    static constexpr uint16 kScaleMin = static_cast<uint16>((kScaleOne * 100U) / (100U + kMaxSkew));
+    static constexpr uint16 kScaleMax = static_cast<uint16>((kScaleOne * 100U) / (100U - kMaxSkew));
+
+    /// [us] Nominal short and long half bit [S-9.1]
+    static constexpr uint32 kNominalShort = 58U;
+    static constexpr uint32 kNominalLong = 100U;
+    /// [us] Acquisition window of short half bits (unscaled), 4 us margin for the resolution of micros()
+    static constexpr uint32 kAcquireMin = (kNominalShort * (100U - kMaxSkew)) / 100U - 4U;
+    static constexpr uint32 kAcquireMax = (kNominalShort * (100U + kMaxSkew)) / 100U + 4U;
+    /// Minimal number of short half bits of a preamble (10 bits [S-9.2])
+    static constexpr uint8 kMinPreamble = 20U;
+    /// Number of short half bits that are summed up (a power of 2, kSumShift = log2)
+    static constexpr uint8 kSumShift = 4U;
+    static constexpr uint8 kSumLength = static_cast<uint8>(1U << kSumShift);
+
+    static_assert(kSumLength <= kMinPreamble, "timing_calibration: kSumLength shall not exceed kMinPreamble");
+
+  protected:
+    /// The bit extractor that receives the scaled time deltas
+    bit_extractor_type& bit_extractor;
+    /// [us] Sum of the first kSumLength time deltas of the current run
+    uint16 sum;
+    /// Number of time deltas of the current run within the acquisition window (saturates at 255)
+    uint8 run_length;
+    /// Scale factor (1/256)
+    uint16 scale;
+    /// Number of preambles used for calibration. Can overflow.
+    uint16 calibration_count;
+
+    /// Update the scale factor with the short half bits of the current run and the long half bit dt
+    void calibrate(uint32 dt) noexcept
+    {
+      // long half bit shall be 1.4 to 2.2 times the mean short half bit: 5 * L * 16 in [7 * sum, 11 * sum]
+      const uint32 long16 = dt << kSumShift;
+      const uint32 s = sum;
+      if ((long16 * 5U < s * 7U) || (long16 * 5U > s * 11U))
+      {
+        return;
+      }
+      // [us/16] measured short + long half bit, scaled with the current factor
+      const sint32 measured16 = static_cast<sint32>(((s + long16) * scale) >> kScaleShift);
+      constexpr sint32 kNominal16 = static_cast<sint32>((kNominalShort + kNominalLong) << kSumShift);
+      // move half the way: d(scale) = scale * (nominal - measured) / nominal / 2 ~ (nominal - measured) * 13 / 256
+      // (with scale ~ 256 and nominal = 2528 us/16)
+      sint32 next = static_cast<sint32>(scale) + ((kNominal16 - measured16) * 13) / 256;
+      if (next < static_cast<sint32>(kScaleMin))
+      {
+        next = kScaleMin;
+      }
+      else if (next > static_cast<sint32>(kScaleMax))
+      {
+        next = kScaleMax;
+      }
+      scale = static_cast<uint16>(next);
+      calibration_count++;
+    }
+
+  public:
+    /// Construct with a reference to the bit extractor
+    timing_calibration(bit_extractor_type& be) noexcept
+      : bit_extractor(be), sum(0U), run_length(0U), scale(kScaleOne), calibration_count(0U)
+    {
+    }
+
+    /**
+     * @brief Measure a time delta and forward it scaled to the bit extractor.
+     *
+     * @param dt Time difference in microseconds since the last edge.
+     */
+    void execute(uint32 dt)
+    {
+      if ((dt >= kAcquireMin) && (dt <= kAcquireMax))
+      {
+        if (run_length < kSumLength)
+        {
+          sum = static_cast<uint16>(sum + dt);
+        }
+        if (run_length < 255U)
+        {
+          run_length++;
+        }
+      }
+      else
+      {
+        if (run_length >= kMinPreamble)
+        {
+          calibrate(dt);
+        }
+        run_length = 0U;
+        sum = 0U;
+      }
+      // time deltas above 0xFFFF us are invalid anyway; avoid an overflow of the multiplication
+      bit_extractor.execute((dt <= 0xFFFFU) ? ((dt * scale) >> kScaleShift) : dt);
+    }
+
+    /**
+     * @brief Measure and forward a buffer of time differences (see execute()).
+     *
+     * @param deltas Time differences in microseconds between subsequent edges.
+     * @param n      Number of elements in deltas.
+     */
+    void execute_many(const uint16 *deltas, size_t n)
+    {
+      for (size_t i = 0U; i < n; i++)
+      {
+        execute(deltas[i]);
+      }
+    }
+
+    /// Returns the scale factor (1/256, kScaleOne = 1.0)
+    uint16 get_scale() const noexcept { return scale; }
+    /// Returns the number of preambles used for calibration. Can overflow.
+    uint16 get_calibration_count() const noexcept { return calibration_count; }
+    /// Restart with scale factor 1.0
+    void reset() noexcept
+    {
+      sum = 0U;
+      run_length = 0U;
+      scale = kScaleOne;
+    }
+  };
+} // namespace dcc
+
+#endif // DCC_TIMINGCALIBRATION_H
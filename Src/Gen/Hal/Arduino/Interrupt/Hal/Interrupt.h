@@ -20,11 +20,10 @@
 #define HAL_INTERRUPT_H
 
 #include <Arduino.h>
+#include <Hal/Common/InterruptContext.h>
 
 namespace hal
 {
-    using func_pointer = void(*)(void);
-
     inline void attachInterrupt(uint8_t isr_nr, func_pointer func, int mode) { ::attachInterrupt(isr_nr, func, mode); }
     inline void detachInterrupt(uint8_t isr_nr) { ::detachInterrupt(isr_nr); }
 }
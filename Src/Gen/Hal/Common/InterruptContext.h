@@ -0,0 +1,97 @@
+/**
+ * @file Hal/Common/InterruptContext.h
+ * @author Ralf Sondershaus
+ *
+ * @brief ISRs with a context pointer, shared by all variants of Hal/Interrupt.h
+ *
+ * Include Hal/Interrupt.h instead of this file. Each variant of Hal/Interrupt.h includes this
+ * file and defines attachInterrupt(uint8_t, func_pointer, int) and detachInterrupt(uint8_t).
+ * 
+ * @copyright Copyright 2024 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HAL_INTERRUPT_CONTEXT_H
+#define HAL_INTERRUPT_CONTEXT_H
+
+#include <Std_Types.h>
+#include <OS_Type.h>
+
+namespace hal
+{
+    using func_pointer = void(*)(void);
+    /// ISR with a context pointer, e.g. the object that handles the interrupt
+    using context_func_pointer = void(*)(void*);
+
+    /// Number of interrupts that can be attached with a context pointer (INT0 ... INT5 of the ATmega2560)
+    constexpr uint8_t kNrContextInterrupts = 6U;
+
+    namespace detail
+    {
+        /// An ISR with context pointer
+        struct isr_context
+        {
+            context_func_pointer func;
+            void* ctx;
+        };
+
+        /// Table of ISRs with context pointer per interrupt number. A class template so that the
+        /// table can be defined in this header.
+        template<class T = void>
+        struct isr_context_table
+        {
+            static isr_context entries[kNrContextInterrupts];
+        };
+        template<class T> isr_context isr_context_table<T>::entries[kNrContextInterrupts];
+
+        /// Trampoline for interrupt number N: calls the ISR of table entry N with its context pointer
+        template<uint8_t N>
+        void isr_trampoline()
+        {
+            const isr_context& e = isr_context_table<>::entries[N];
+            e.func(e.ctx);
+        }
+
+        /// The trampolines, one per interrupt number
+        constexpr func_pointer kTrampolines[kNrContextInterrupts] = 
+        {
+            &isr_trampoline<0>, &isr_trampoline<1>, &isr_trampoline<2>, 
+            &isr_trampoline<3>, &isr_trampoline<4>, &isr_trampoline<5>
+        };
+    }
+
+    /// Defined by each variant of Hal/Interrupt.h
+    inline void attachInterrupt(uint8_t isr_nr, func_pointer func, int mode);
+    inline void detachInterrupt(uint8_t isr_nr);
+
+    /**
+     * @brief Attach an ISR with a context pointer, e.g. to handle the interrupts of multiple 
+     * input pins with multiple objects of the same class. func is called with ctx via a 
+     * trampoline per interrupt number.
+     * 
+     * The table entry is written with interrupts suspended because the trampoline of isr_nr
+     * might still be attached and read a half written entry.
+     * 
+     * @param isr_nr Interrupt number (see digitalPinToInterrupt())
+     * @param func   ISR, called with ctx
+     * @param ctx    Context pointer
+     * @param mode   CHANGE, FALLING or RISING
+     * @return true if the ISR is attached, false if isr_nr is not supported
+     */
+    inline bool attachInterrupt(uint8_t isr_nr, context_func_pointer func, void* ctx, int mode)
+    {
+        bool ret = false;
+        if (isr_nr < kNrContextInterrupts)
+        {
+            SuspendAllInterrupts();
+            detail::isr_context_table<>::entries[isr_nr] = detail::isr_context{ func, ctx };
+            ResumeAllInterrupts();
+            attachInterrupt(isr_nr, detail::kTrampolines[isr_nr], mode);
+            ret = true;
+        }
+        return ret;
+    }
+}
+
+#endif // HAL_INTERRUPT_CONTEXT_H
@@ -25,5 +25,6 @@ namespace hal
         uint8 isr_nr;
         func_pointer func;
         int isr_mode;
+        func_pointer funcs[kNrContextInterrupts];
     }
 }
@@ -20,6 +20,7 @@
 #define HAL_INTERRUPT_H
 
 #include <Std_Types.h>
+#include <Hal/Common/InterruptContext.h>
 
 #define NOT_AN_INTERRUPT -1
 
@@ -29,13 +30,23 @@
 
 namespace hal
 {
-    using func_pointer = void(*)(void);
     namespace stubs
     {
         
         extern uint8 isr_nr;
         extern func_pointer func;
         extern int isr_mode; // CHANGE, FALLING, RISING
+        /// The attached ISR per interrupt number (nullptr if detached)
+        extern func_pointer funcs[kNrContextInterrupts];
+
+        /// Call the ISR that is attached to interrupt nr (if any), e.g. to simulate an edge
+        inline void trigger_interrupt(uint8_t nr)
+        {
+            if ((nr < kNrContextInterrupts) && (funcs[nr] != nullptr))
+            {
+                funcs[nr]();
+            }
+        }
     }
 
     // This is the MEGA variant
@@ -46,10 +57,18 @@ namespace hal
         stubs::isr_nr = isr_nr;
         stubs::func = func;
         stubs::isr_mode = mode;
+        if (isr_nr < kNrContextInterrupts)
+        {
+            stubs::funcs[isr_nr] = func;
+        }
     }
     inline void detachInterrupt(uint8_t isr_nr)
     {
         stubs::isr_nr = isr_nr;
+        if (isr_nr < kNrContextInterrupts)
+        {
+            stubs::funcs[isr_nr] = nullptr;
+        }
     }
 }
 
@@ -22,5 +22,6 @@ namespace hal
     {
         uint32 micros;
         uint32 millis;
+        uint32 micros_reads;
     }
 }
@@ -37,10 +37,12 @@ namespace hal
     {
         extern uint32 micros;
         extern uint32 millis;
+        /// Number of calls of micros(), e.g. to measure the overhead of a scheduler
+        extern uint32 micros_reads;
     }
 
     inline uint32 millis() { return stubs::millis; }
-    inline uint32 micros() { return stubs::micros; }
+    inline uint32 micros() { stubs::micros_reads++; return stubs::micros; }
 }
 
 #endif // HAL_TIMER_H
\ No newline at end of file
@@ -26,5 +26,8 @@
 #define ROM_READ_STRING(dst, src) strcpy((dst), (src))
 #define ROM_READ_STRUCT(dst, src, len) memcpy((dst), (src), (len))
 
+/* Compiler barrier: memory accesses are not reordered across this point */
+#define COMPILER_BARRIER()      _ReadWriteBarrier()
+
 #endif // COMPILER_H
 // EOF
\ No newline at end of file
@@ -11,8 +11,6 @@
  */
 
 #include <Util/Array.h>
-#include <Util/bitset.h>
-#include <Util/String_view.h>
 #include <Util/Timer.h>
 #include <Rte/Rte.h>
 #include <Rte/Rte_Types_Ifc.h>
@@ -75,27 +73,118 @@ namespace rte
 #include <Rte/Rte_Cfg_Prj.h>
 #undef RTE_DEF_MODE_EVENT_RUNABLES
 
-#define RTE_DEF_MODE_EVENT_RUNABLE_ENUM
-#include <Rte/Rte_Cfg_Mac.h>
-#include <Rte/Rte_Cfg_Prj.h>
-#undef RTE_DEF_MODE_EVENT_RUNABLE_ENUM
-
 #define RTE_DEF_MODE_EVENT_RUNABLE_ARRAY
 #include <Rte/Rte_Cfg_Mac.h>
 #include <Rte/Rte_Cfg_Prj.h>
 #undef RTE_DEF_MODE_EVENT_RUNABLE_ARRAY
 
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+namespace rte
+{
+  /// Number of profiled runables: init runables first, cyclic runables next
+  constexpr size_t kNrProfiledRunables = static_cast<size_t>(kRI_Max) + static_cast<size_t>(kRC_Max);
+
+  /// Profiling values of the runables, kProfiling_NrValues values per runable (port rte_profiling)
+  util::array<uint32, kNrProfiledRunables * kProfiling_NrValues> aProfiling;
+
+  /// Name of the port
+  constexpr char port_name_rte_profiling[] ROM_CONST_VAR = "rte_profiling";
+} // namespace rte
+#endif
+
 #define RTE_DEF_MODE_PORT
 #include <Rte/Rte_Cfg_Mac.h>
 #include <Rte/Rte_Cfg_Prj.h>
 #undef RTE_DEF_MODE_PORT
 
 #ifdef RTE_CFG_PORT_SR_AVAILABLE
-// Just in case this feature is active, define the port array
+// Just in case this feature is active, define the port names and the port array
+#define RTE_DEF_MODE_PORT_NAME
+#include <Rte/Rte_Cfg_Mac.h>
+#include <Rte/Rte_Cfg_Prj.h>
+#undef RTE_DEF_MODE_PORT_NAME
+
+#define RTE_DEF_MODE_PORT_NAME_ARRAY
+#include <Rte/Rte_Cfg_Mac.h>
+#include <Rte/Rte_Cfg_Prj.h>
+#undef RTE_DEF_MODE_PORT_NAME_ARRAY
+
 #define RTE_DEF_MODE_PORT_ARRAY
 #include <Rte/Rte_Cfg_Mac.h>
 #include <Rte/Rte_Cfg_Prj.h>
 #undef RTE_DEF_MODE_PORT_ARRAY
+
+namespace rte
+{
+  /// Number of SR ports
+  constexpr size_t kNrPorts = sizeof(aPortNames) / sizeof(aPortNames[0]);
+
+  static_assert(kNrPorts <= 0xFFFFu, "RTE: too many ports");
+
+  /// Compare two port names like strcmp() (compile time)
+  constexpr int comparePortNames(const char * szName1, const char * szName2)
+  {
+    while ((*szName1 != '\0') && (*szName1 == *szName2))
+    {
+      szName1++;
+      szName2++;
+    }
+    return static_cast<int>(static_cast<uint8>(*szName1)) - static_cast<int>(static_cast<uint8>(*szName2));
+  }
+
+  /// Length of the longest port name (compile time)
+  constexpr size_t maxPortNameLength()
+  {
+    size_t nMax = 0U;
+    for (size_t idx = 0U; idx < kNrPorts; idx++)
+    {
+      size_t n = 0U;
+      while (aPortNames[idx][n] != '\0')
+      {
+        n++;
+      }
+      nMax = (n > nMax) ? n : nMax;
+    }
+    return nMax;
+  }
+
+  static_assert(maxPortNameLength() <= kMaxLenPortName, "RTE: port name is longer than kMaxLenPortName");
+
+  /// Index array of type uint16 that sorts aPorts by name
+  typedef util::array<uint16, kNrPorts> port_order_array;
+
+  /// Returns the indices of aPorts sorted by port name (insertion sort at compile time)
+  constexpr port_order_array sortPortNames()
+  {
+    port_order_array order{};
+    for (size_t idx = 0U; idx < kNrPorts; idx++)
+    {
+      size_t pos = idx;
+      while ((pos > 0U) && (comparePortNames(aPortNames[order[pos - 1U]], aPortNames[idx]) > 0))
+      {
+        order[pos] = order[pos - 1U];
+        pos--;
+      }
+      order[pos] = static_cast<uint16>(idx);
+    }
+    return order;
+  }
+
+  /// Indices of aPorts sorted by port name for binary search in getPortData(const char *)
+  constexpr port_order_array aPortOrder ROM_CONST_VAR = sortPortNames();
+
+  /// Compare the port name szName with the port name szRomName in ROM like strcmp()
+  static int compareRomPortName(const char * szName, const char * szRomName)
+  {
+    uint8 c;
+    while (((c = ROM_READ_BYTE(szRomName)) != 0U) && (static_cast<uint8>(*szName) == c))
+    {
+      szName++;
+      szRomName++;
+    }
+    return static_cast<int>(static_cast<uint8>(*szName)) - static_cast<int>(c);
+  }
+} // namespace rte
 #endif
 
 namespace rte
@@ -109,15 +198,95 @@ namespace rte
   // RCB array type
   typedef util::array<rcb_type, kRC_Max> rcb_array;
 
-  // 32 events
-  typedef util::bitset<uint32, 32> event_array;
-
-
   /// The RCBs
   rcb_array aRcb;
-  /// Events
+
+  /// [us] Earliest next release time of all cyclic runables. exec() doesn't scan the RCBs before.
+  time_type ulNextRelease;
+
+  /// Called by exec() if no runable is due (nullptr: no idle hook)
+  idle_hook_type pIdleHook = nullptr;
+
+  /// Maximal time difference of two time stamps (see MicroTimer::timeout())
+  constexpr time_type kMaxTimeDelta = static_cast<time_type>(0x7FFFFFFFu);
+
+#ifdef RTE_CFG_EVENT_AVAILABLE
+  // One byte per event: setEvent() and exec() write a byte only (no read-modify-write), which is
+  // atomic on 8-bit targets, so events can be set from an ISR without disabling interrupts.
+  typedef util::array<volatile uint8, kEvent_Max> event_array;
+
+  /// Pending events
   event_array aEvents;
 
+  /// Run the event runables of pending events once, in the order of their definition (priority)
+  static void dispatchEvents()
+  {
+    for (size_t idx = 0; idx < static_cast<size_t>(kEvent_Max); idx++)
+    {
+      if (aEvents[idx] != 0U)
+      {
+        // clear before the call so that an event that is set while the runable runs is not lost
+        aEvents[idx] = 0U;
+        aEventRunables[idx]->run();
+      }
+    }
+  }
+
+  /// Returns true if an event is pending
+  static bool isEventPending()
+  {
+    for (auto it_event = aEvents.begin(); it_event != aEvents.end(); it_event++)
+    {
+      if (*it_event != 0U)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+#endif
+
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+  /// Add a time to its minimum, maximum and sum (three values on port rte_profiling)
+  static void profileTime(uint32 * pMinMaxSum, uint32 ulTime, bool bFirst, bool bSum)
+  {
+    if (bFirst || (ulTime < pMinMaxSum[0]))
+    {
+      pMinMaxSum[0] = ulTime;
+    }
+    if (ulTime > pMinMaxSum[1])
+    {
+      pMinMaxSum[1] = ulTime;
+    }
+    if (bSum)
+    {
+      pMinMaxSum[2] += ulTime;
+    }
+  }
+
+  /// Add a run of runable idx (see kNrProfiledRunables) to port rte_profiling. Averages are
+  /// calculated by the reader of the port.
+  static void profile(size_t idx, time_type ulRunTime, time_type ulJitter, bool bOverrun)
+  {
+    uint32 * const pValues = &aProfiling[idx * kProfiling_NrValues];
+    const uint32 ulRun = static_cast<uint32>(ulRunTime);
+    const uint32 ulJit = static_cast<uint32>(ulJitter);
+    const bool bFirst = (pValues[kProfiling_Count] == 0U);
+    // stop count and sums before a sum overflows
+    const bool bSum = (ulRun <= ~pValues[kProfiling_RunTimeSum]) && (ulJit <= ~pValues[kProfiling_JitterSum]);
+    if (bSum)
+    {
+      pValues[kProfiling_Count]++;
+    }
+    profileTime(&pValues[kProfiling_RunTimeMin], ulRun, bFirst, bSum);
+    profileTime(&pValues[kProfiling_JitterMin], ulJit, bFirst, bSum);
+    if (bOverrun)
+    {
+      pValues[kProfiling_Overruns]++;
+    }
+  }
+#endif
+
   //rcb_array::iterator it_rcb_cur;
 
   void start()
@@ -133,14 +302,36 @@ namespace rte
       it_rcb_cfg++;
     }
 
+    // scan the RCBs in the first call of exec()
+    ulNextRelease = timer_type::getCurrentTime();
+
+#ifdef RTE_CFG_EVENT_AVAILABLE
     // clear events
-    aEvents.reset();
+    for (auto it_event = aEvents.begin(); it_event != aEvents.end(); it_event++)
+    {
+      *it_event = 0U;
+    }
+#endif
+
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+    // clear profiling data
+    for (auto it_value = aProfiling.begin(); it_value != aProfiling.end(); it_value++)
+    {
+      *it_value = 0U;
+    }
+#endif
 
     // call init runables
     auto it_init_cfg = aInitRunables.begin();
     while (it_init_cfg != aInitRunables.end())
     {
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+      const time_type ulStart = timer_type::getCurrentTime();
+      (*it_init_cfg)->run();
+      profile(static_cast<size_t>(it_init_cfg - aInitRunables.begin()), timer_type::getCurrentTime() - ulStart, 0U, false);
+#else
       (*it_init_cfg)->run();
+#endif
       it_init_cfg++;
     }
 
@@ -153,33 +344,83 @@ namespace rte
 
   void exec()
   {
+#ifdef RTE_CFG_EVENT_AVAILABLE
+    dispatchEvents();
+#endif
+    // read the time once per call; skip the scan of the RCBs until the earliest next release time
+    const time_type ulNow = timer_type::getCurrentTime();
+    if ((static_cast<time_type>(ulNow - ulNextRelease) & static_cast<time_type>(0x80000000u)) != static_cast<time_type>(0u))
+    {
+      if (pIdleHook != nullptr)
+      {
+#ifdef RTE_CFG_EVENT_AVAILABLE
+        if (!isEventPending())
+#endif
+        {
+          pIdleHook(static_cast<uint32>(ulNextRelease - ulNow));
+        }
+      }
+      return;
+    }
+
+    // run due runables and find the earliest next release time
+    time_type ulMinDelta = kMaxTimeDelta;
     auto it_rcb = aRcb.begin();
     auto it_rcb_cfg = aCyclicRunables.begin();
     while (it_rcb != aRcb.end())
     {
-      if (it_rcb->timer.timeout())
+      if (it_rcb->timer.timeout(ulNow))
       {
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+        // one time stamp pair per run
+        const time_type ulRelease = it_rcb->timer.getTimer();
+        const time_type ulStart = timer_type::getCurrentTime();
+        it_rcb_cfg->pRnbl->run();
+        const time_type ulEnd = timer_type::getCurrentTime();
+        profile(static_cast<size_t>(kRI_Max) + static_cast<size_t>(it_rcb - aRcb.begin()),
+                ulEnd - ulStart, ulStart - ulRelease, (ulEnd - ulRelease) >= it_rcb_cfg->ulCycleTime);
+#else
         it_rcb_cfg->pRnbl->run();
+#endif
         (void)(it_rcb->timer.increment(it_rcb_cfg->ulCycleTime));
       }
+      time_type ulDelta = static_cast<time_type>(it_rcb->timer.getTimer() - ulNow);
+      if (ulDelta > kMaxTimeDelta)
+      {
+        // still overdue (the runable needs more than its cycle time): release in the next call
+        ulDelta = 0U;
+      }
+      if (ulDelta < ulMinDelta)
+      {
+        ulMinDelta = ulDelta;
+      }
       it_rcb++;
       it_rcb_cfg++;
     }
+    ulNextRelease = ulNow + ulMinDelta;
+  }
+
+  void setIdleHook(idle_hook_type pHook)
+  {
+    pIdleHook = pHook;
   }
 
   void setEvent(uint32 ulEventId)
   {
+#ifdef RTE_CFG_EVENT_AVAILABLE
+    if (ulEventId < static_cast<uint32>(kEvent_Max))
+    {
+      aEvents[ulEventId] = 1U;
+    }
+#else
     (void)ulEventId;
-    //if (ulEventId < kEvent_Max)
-    //{ 
-    //  aEvents.set(ulEventId, true);
-    //}
+#endif
   }
 
   size_t getNrPorts()
   {
   #ifdef RTE_CFG_PORT_SR_AVAILABLE
-    return sizeof(aPorts) / sizeof(port_data_t);
+    return kNrPorts;
   #else
     return 0;
   #endif
@@ -207,14 +448,27 @@ namespace rte
   {
     port_data_t * p = nullptr;
   #ifdef RTE_CFG_PORT_SR_AVAILABLE
-    size_t idx;
-    for (idx = 0; idx < getNrPorts(); idx++)
+    // binary search in the port names sorted at compile time
+    size_t first = 0U;
+    size_t last = kNrPorts;
+    while (first < last)
     {
-      if (util::string_view{aPorts[idx].szName}.compare(portName) == 0)
+      const size_t mid = first + ((last - first) >> 1U);
+      const size_t idx = ROM_READ_WORD(&aPortOrder[mid]);
+      const int cmp = compareRomPortName(portName, aPorts[idx].szName);
+      if (cmp == 0)
       {
         p = &aPorts[idx];
         break;
       }
+      else if (cmp < 0)
+      {
+        last = mid;
+      }
+      else
+      {
+        first = mid + 1U;
+      }
     }
   #else
     (void) portName;
@@ -21,7 +21,28 @@ namespace rte
 {
   typedef uint32 tEvntId;
 
+  /// Idle hook, called with the time [us] until the next cyclic runable is due
+  typedef void (*idle_hook_type)(uint32 ulTimeToNextRelease);
+
   constexpr tEvntId kInvalidEventId = static_cast<tEvntId>(0xFFFFFFFFU);
+
+  // Values per runable on port rte_profiling if RTE_CFG_PROFILING_AVAILABLE is defined (init
+  // runables first, cyclic runables next, in the order of their definition). Times in [us].
+  // Release jitter is the start of a run minus its release time; an overrun is a run that ends
+  // after the next release time. The reader of the port calculates average values as sum / count.
+  // Count and sums stop when a sum would overflow, so that their ratio stays the average.
+  enum : uint8
+  {
+    kProfiling_Count = 0,       ///< Number of runs in the sums
+    kProfiling_RunTimeMin,      ///< Minimal run time
+    kProfiling_RunTimeMax,      ///< Maximal run time
+    kProfiling_RunTimeSum,      ///< Sum of run times
+    kProfiling_JitterMin,       ///< Minimal release jitter
+    kProfiling_JitterMax,       ///< Maximal release jitter
+    kProfiling_JitterSum,       ///< Sum of release jitters
+    kProfiling_Overruns,        ///< Number of overruns
+    kProfiling_NrValues
+  };
 }
 
 #include <Rte/Rte_Cfg_Ext.h>
@@ -30,9 +51,28 @@ namespace rte
 {
   void start();
   void stop();
+  // Dispatches pending events and runs the cyclic runables that are due. Reads the time once per
+  // call and scans the cyclic runables only if the earliest next release time is reached.
   void exec();
+
+  // Sets a hook that exec() calls if no cyclic runable is due and no event is pending, e.g. to
+  // enter an idle sleep mode until the next interrupt. The hook shall return before the next
+  // release time (parameter, [us]) and shall wake up on interrupts that set events.
+  // nullptr: no idle hook (default).
+  void setIdleHook(idle_hook_type pHook);
+
+  // Sets the event ulEventId (kEvent_<eventname>, see RTE_DEF_EVENT_RUNABLE). The next call of
+  // exec() runs the event runable before the cyclic runables. Events are dispatched in the order
+  // of their definition (first = highest priority). Can be called from an ISR. Requires
+  // RTE_CFG_EVENT_AVAILABLE in Rte_Cfg_Prj.h, e.g.
+  //   #ifndef RTE_CFG_EVENT_AVAILABLE
+  //   #define RTE_CFG_EVENT_AVAILABLE
+  //   #endif
   void setEvent(uint32 ulEventId);
 
+  // Maximal length of a port name (without terminating '\0')
+  constexpr size_t kMaxLenPortName = 31U;
+
   // These functions return non-zero values if the RTE is configured
   // with RTE_CFG_PORT_SR_AVAILABLE, e.g. add to Rte_cfg_Prj.h:
   //   #ifndef RTE_CFG_PORT_SR_AVAILABLE
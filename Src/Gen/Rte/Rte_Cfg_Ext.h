@@ -19,6 +19,11 @@
 #include <Rte/Rte_Cfg_Prj.h>
 #undef RTE_DEF_MODE_OBJ_EXT
 
+#define RTE_DEF_MODE_EVENT_RUNABLE_ENUM
+#include <Rte/Rte_Cfg_Mac.h>
+#include <Rte/Rte_Cfg_Prj.h>
+#undef RTE_DEF_MODE_EVENT_RUNABLE_ENUM
+
 #define RTE_DEF_MODE_PORT_EXT
 #include <Rte/Rte_Cfg_Mac.h>
 #include <Rte/Rte_Cfg_Prj.h>
@@ -323,9 +323,9 @@
 #define RTE_DEF_CYCLIC_RUNABLE_START             
 #define RTE_DEF_CYCLIC_RUNABLE(cls, obj, func, time_off, time_cyc)
 #define RTE_DEF_CYCLIC_RUNABLE_END
-#define RTE_DEF_EVENT_RUNABLE_START                       util::array<Runable * const, kEvent_Max> aEventRunables = {
+#define RTE_DEF_EVENT_RUNABLE_START                       util::array<runable_const_pointer, kEvent_Max> aEventRunables = { {
 #define RTE_DEF_EVENT_RUNABLE(eventname, cls, obj, func)  &re_##obj##func,
-#define RTE_DEF_EVENT_RUNABLE_END                         };
+#define RTE_DEF_EVENT_RUNABLE_END                         } };
 #define RTE_DEF_PORT_SR(cls,port)
 #define RTE_DEF_PORT_SR_CONTAINER(cls,port)
 #define RTE_DEF_PORT_SR_START
@@ -391,6 +391,9 @@
     extern cls obj; \
     inline ifc_base::ret_type write(const cls::data_type& param) { return obj.write(param); } \
     inline ifc_base::ret_type read(cls::data_type& param) { return obj.read(param); } \
+    inline ifc_base::ret_type readSnapshot(cls::data_type& param) { return obj.readSnapshot(param); } \
+    inline version_type getVersion() { return obj.getVersion(); } \
+    inline cls::view_type view() { return obj.view(); } \
   }
 #define RTE_DEF_PORT_SR_CONTAINER(cls,port) \
   namespace port \
@@ -398,7 +401,13 @@
     extern cls obj; \
     inline ifc_base::ret_type write(const cls::array_type& param) { return obj.write(param); } \
     inline ifc_base::ret_type read(cls::array_type& param) { return obj.read(param); } \
+    inline ifc_base::ret_type update(const cls::array_type& param) { return obj.update(param); } \
+    inline ifc_base::ret_type readSnapshot(cls::array_type& param) { return obj.readSnapshot(param); } \
+    inline version_type getVersion() { return obj.getVersion(); } \
+    inline cls::view_type view() { return obj.view(); } \
     inline ifc_base::ret_type writeElement(cls::size_type pos, const cls::value_type& param) { return obj.writeElement(pos, param); } \
+    inline void beginWrite() { obj.beginWrite(); } \
+    inline void endWrite() { obj.endWrite(); } \
     inline ifc_base::ret_type readElement(cls::size_type pos, cls::value_type& param) { return obj.readElement(pos, param); } \
     /*inline cls::const_iterator begin() { return obj.begin(); }*/ \
     /*inline cls::const_iterator end() { return obj.end(); }*/ \
@@ -418,12 +427,64 @@
 #define RTE_DEF_PORT_CS_END
 #endif
 
+// ----------------------------------------------------------------------
+/// Names of SR ports in ROM and a constexpr array of the names (in the order of aPorts)
+/// to sort them at compile time (see Rte.cpp)
+// ----------------------------------------------------------------------
 // 16.3.2 The # operator [cpp.stringize]
 //
 // A character string literal is a string-literal with no prefix. 
 // If, in the replacement list, a parameter is immediately preceded by a # preprocessing token, 
 // both are replaced by a single character string literal preprocessing token that contains the
 // spelling of the preprocessing token sequence for the corresponding argument
+#ifdef RTE_DEF_MODE_PORT_NAME
+#define RTE_DEF_OBJ_START
+#define RTE_DEF_OBJ_END
+#define RTE_DEF_OBJ(cls, obj)
+#define RTE_DEF_INIT_RUNABLE_START
+#define RTE_DEF_INIT_RUNABLE(cls, obj, func)
+#define RTE_DEF_INIT_RUNABLE_END
+#define RTE_DEF_CYCLIC_RUNABLE_START
+#define RTE_DEF_CYCLIC_RUNABLE(cls, obj, func, time_off, time_cyc)
+#define RTE_DEF_CYCLIC_RUNABLE_END
+#define RTE_DEF_EVENT_RUNABLE_START
+#define RTE_DEF_EVENT_RUNABLE(eventname, cls, obj, func)
+#define RTE_DEF_EVENT_RUNABLE_END
+#define RTE_DEF_PORT_SR(cls,port)            constexpr char port_name_##port[] ROM_CONST_VAR = #port;
+#define RTE_DEF_PORT_SR_CONTAINER(cls,port)  constexpr char port_name_##port[] ROM_CONST_VAR = #port;
+#define RTE_DEF_PORT_SR_START
+#define RTE_DEF_PORT_SR_END
+#define RTE_DEF_PORT_CS(cls,port,srvobj,func)
+#define RTE_DEF_PORT_CS_START
+#define RTE_DEF_PORT_CS_END
+#endif
+
+#ifdef RTE_DEF_MODE_PORT_NAME_ARRAY
+#define RTE_DEF_OBJ_START
+#define RTE_DEF_OBJ_END
+#define RTE_DEF_OBJ(cls, obj)
+#define RTE_DEF_INIT_RUNABLE_START
+#define RTE_DEF_INIT_RUNABLE(cls, obj, func)
+#define RTE_DEF_INIT_RUNABLE_END
+#define RTE_DEF_CYCLIC_RUNABLE_START
+#define RTE_DEF_CYCLIC_RUNABLE(cls, obj, func, time_off, time_cyc)
+#define RTE_DEF_CYCLIC_RUNABLE_END
+#define RTE_DEF_EVENT_RUNABLE_START
+#define RTE_DEF_EVENT_RUNABLE(eventname, cls, obj, func)
+#define RTE_DEF_EVENT_RUNABLE_END
+#define RTE_DEF_PORT_SR(cls,port)            port_name_##port,
+#define RTE_DEF_PORT_SR_CONTAINER(cls,port)  port_name_##port,
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+#define RTE_DEF_PORT_SR_START     constexpr const char * aPortNames[] = { port_name_rte_profiling,
+#else
+#define RTE_DEF_PORT_SR_START     constexpr const char * aPortNames[] = {
+#endif
+#define RTE_DEF_PORT_SR_END       };
+#define RTE_DEF_PORT_CS(cls,port,srvobj,func)
+#define RTE_DEF_PORT_CS_START
+#define RTE_DEF_PORT_CS_END
+#endif
+
 #ifdef RTE_DEF_MODE_PORT_ARRAY
 #define RTE_DEF_OBJ_START
 #define RTE_DEF_OBJ_END
@@ -437,9 +498,14 @@
 #define RTE_DEF_EVENT_RUNABLE_START
 #define RTE_DEF_EVENT_RUNABLE(eventname, cls, obj, func)
 #define RTE_DEF_EVENT_RUNABLE_END
-#define RTE_DEF_PORT_SR(cls,port)            { port::obj.data(), #port, port::obj.size(), sizeof(cls::data_type) },
-#define RTE_DEF_PORT_SR_CONTAINER(cls,port)  { port::obj.data(), #port, port::obj.size(), sizeof(cls::value_type) },
+#define RTE_DEF_PORT_SR(cls,port)            { port::obj.data(), port_name_##port, port::obj.size(), sizeof(cls::data_type) },
+#define RTE_DEF_PORT_SR_CONTAINER(cls,port)  { port::obj.data(), port_name_##port, port::obj.size(), sizeof(cls::value_type) },
+#ifdef RTE_CFG_PROFILING_AVAILABLE
+// The RTE adds the port rte_profiling in front of the project specific ports (see Rte.cpp)
+#define RTE_DEF_PORT_SR_START     port_data_t aPorts[] = { { aProfiling.data(), port_name_rte_profiling, aProfiling.size(), sizeof(uint32) },
+#else
 #define RTE_DEF_PORT_SR_START     port_data_t aPorts[] = {
+#endif
 #define RTE_DEF_PORT_SR_END       };
 #define RTE_DEF_PORT_CS(cls,port,srvobj,func)
 #define RTE_DEF_PORT_CS_START
@@ -7,6 +7,15 @@
  *        - ifc_sr_array  (Sender Receiver for container types)
  *        - ifc_cs        (Client Server)
  *
+ *        SR interfaces count their writes (version). A reader can compare the version with the
+ *        version of its last read to skip work if the data didn't change. readSnapshot() returns
+ *        consistent data if the data is written in an interrupt service routine (seqlock): the
+ *        version is odd while a write is in progress, and the reader retries if the version was
+ *        odd or changed while it copied the data. Only one writer is allowed, and readSnapshot()
+ *        shall not be called from an ISR that interrupts a writer. Writers of several elements
+ *        of an ifc_sr_array enclose them with beginWrite() and endWrite(), so that readers see
+ *        all or none of them.
+ *
  * @copyright Copyright 2020 - 2022 Ralf Sondershaus
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -15,8 +24,45 @@
 #ifndef RTE_TYPE_IFC_H__
 #define RTE_TYPE_IFC_H__
 
+#include <Std_Types.h>
+
 namespace rte
 {
+  /// Version of SR interfaces: one byte so that it is read and written atomically on 8-bit targets.
+  /// Incremented by 2 with each write, wraps around.
+  typedef uint8 version_type;
+
+  // ----------------------------------------------------------
+  /// Read only view of the data of a SR interface (pointer + size) without a copy.
+  /// The data can change while the view is used (see readSnapshot()).
+  // ----------------------------------------------------------
+  template<typename T>
+  class ifc_view
+  {
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using const_pointer = const value_type*;
+    using const_reference = const value_type&;
+
+  protected:
+    const_pointer pData;
+    size_type unSize;
+
+  public:
+    /// Construct
+    constexpr ifc_view(const_pointer p, size_type n) noexcept : pData(p), unSize(n) {}
+    /// Returns a pointer to the first element
+    constexpr const_pointer data() const noexcept { return pData; }
+    /// Returns the number of elements
+    constexpr size_type size() const noexcept { return unSize; }
+    /// Element at pos. No bounds checking is performed.
+    constexpr const_reference operator[](size_type pos) const noexcept { return pData[pos]; }
+    /// Iterators
+    constexpr const_pointer begin() const noexcept { return pData; }
+    constexpr const_pointer end() const noexcept { return pData + unSize; }
+  };
+
   // ----------------------------------------------------------
   /// Base class for RTE interfaces
   // ----------------------------------------------------------
@@ -47,13 +93,42 @@ namespace rte
     using pointer = data_type*;
     using const_pointer = const data_type*;
   
+    using view_type = ifc_view<data_type>;
+
   protected:
     data_type mData;
+    /// Number of writes * 2, odd while a write is in progress
+    volatile version_type mVersion = 0U;
 
   public:
     /// Read and write data. Default implementation uses operator=. 
     ret_type read (      data_type& t) const { t = mData; return Base::OK; }
-    ret_type write(const data_type& t)       { mData = t; return Base::OK; }
+    ret_type write(const data_type& t)
+    {
+      mVersion = static_cast<version_type>(mVersion + 1U);
+      COMPILER_BARRIER();
+      mData = t;
+      COMPILER_BARRIER();
+      mVersion = static_cast<version_type>(mVersion + 1U);
+      return Base::OK;
+    }
+    /// Read consistent data if the data is written in an ISR (see file header)
+    ret_type readSnapshot(data_type& t) const
+    {
+      version_type v;
+      do
+      {
+        v = mVersion;
+        COMPILER_BARRIER();
+        t = mData;
+        COMPILER_BARRIER();
+      } while (((v & 1U) != 0U) || (v != mVersion));
+      return Base::OK;
+    }
+    /// Returns the version, which changes with each write
+    version_type getVersion() const { return mVersion; }
+    /// Returns a read only view of the data
+    view_type view() const { return view_type(&mData, 1U); }
     /// size
     size_type size() const { return 1; }
     /// Returns a pointer to the data element
@@ -79,10 +154,39 @@ namespace rte
     using pointer = typename array_type::pointer;
     using const_pointer = typename array_type::const_pointer;
 
+    using view_type = ifc_view<value_type>;
+
   protected:
     array_type mData;
+    /// Number of writes * 2, odd while a write is in progress
+    volatile version_type mVersion = 0U;
+    /// Number of nested beginWrite() without endWrite(). Written by the writer only.
+    uint8 mWriteDepth = 0U;
 
   public:
+    /// Start a write: increments the version (odd) unless a write is in progress already. Calls
+    /// can be nested, so that write() and writeElement() between beginWrite() and endWrite()
+    /// change the version only once.
+    void beginWrite()
+    {
+      if (mWriteDepth == 0U)
+      {
+        mVersion = static_cast<version_type>(mVersion + 1U);
+        COMPILER_BARRIER();
+      }
+      mWriteDepth++;
+    }
+    /// End a write: increments the version (even) with the outermost call
+    void endWrite()
+    {
+      mWriteDepth--;
+      if (mWriteDepth == 0U)
+      {
+        COMPILER_BARRIER();
+        mVersion = static_cast<version_type>(mVersion + 1U);
+      }
+    }
+
     /// Helper class: non const iterator
 /*    class iterator
     {
@@ -118,10 +222,37 @@ namespace rte
     //const_iterator end() const noexcept { return const_iterator(*this, mData.end()); }
     /// Read and write array. Default implementation uses operator=. 
     ret_type read(array_type& t) const { t = mData; return Base::OK; }
-    ret_type write(const array_type& t) { mData = t; return Base::OK; }
-    /// Read and write a single element
+    ret_type write(const array_type& t) { beginWrite(); mData = t; endWrite(); return Base::OK; }
+    /// Write the array only if an element changed, so that the version changes only if the data changes
+    ret_type update(const array_type& t)
+    {
+      size_type pos = 0U;
+      while ((pos < size()) && (mData.at(pos) == t.at(pos)))
+      {
+        pos++;
+      }
+      return (pos < size()) ? write(t) : Base::OK;
+    }
+    /// Read a consistent array if the array is written in an ISR (see file header)
+    ret_type readSnapshot(array_type& t) const
+    {
+      version_type v;
+      do
+      {
+        v = mVersion;
+        COMPILER_BARRIER();
+        t = mData;
+        COMPILER_BARRIER();
+      } while (((v & 1U) != 0U) || (v != mVersion));
+      return Base::OK;
+    }
+    /// Returns the version, which changes with each write
+    version_type getVersion() const { return mVersion; }
+    /// Returns a read only view of the array
+    view_type view() const { return view_type(mData.data(), mData.size()); }
+    /// Read and write a single element. Enclose writes of several elements with beginWrite() and endWrite().
     ret_type readElement(size_type pos, value_type& v) const { v = mData.at(pos); return Base::OK; }
-    ret_type writeElement(size_type pos, const value_type& v) { mData.at(pos) = v; return Base::OK; }
+    ret_type writeElement(size_type pos, const value_type& v) { beginWrite(); mData.at(pos) = v; endWrite(); return Base::OK; }
     /// size
     size_type size() const { return mData.size(); }
     /// Returns true if pos is a valid index (is within boundaries)
@@ -206,7 +337,7 @@ namespace rte
   {
     /// Pointer to the data or first element of the array
     void * pData;
-    /// Name of the port (interface)
+    /// Name of the port (interface) in ROM, read with ROM_READ_STRING() or ROM_READ_BYTE()
     const char * szName;
     /// Number of elements in pData (>= 1)
     const size_t size;
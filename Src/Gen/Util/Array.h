@@ -79,7 +79,7 @@ namespace util
     reference at(size_type pos) { return elements[pos]; }
     constexpr const_reference at(size_type pos) const { return elements[pos]; }
     /// Returns a reference to the element at specified location pos. No bounds checking is performed.
-    reference operator[](size_type pos) { return elements[pos]; }
+    constexpr reference operator[](size_type pos) { return elements[pos]; }
     constexpr const_reference operator[](size_type pos) const { return elements[pos]; }
     /// Returns a reference to the first element in the container. Calling front on an empty container is undefined.
     reference front() { return elements[0]; }
@@ -0,0 +1,227 @@
+/**
+  * @file Spsc_Queue.h
+  *
+  * @author Ralf Sondershaus
+  *
+  * @brief util::spsc_queue is a lock-free single-producer single-consumer FIFO.
+  *
+  * The producer (typically an ISR) only writes the head index and the consumer (typically
+  * the main loop) only writes the tail index. Both indices are single bytes, so reading and
+  * writing them is atomic on 8-bit targets and interrupts never need to be disabled. Only
+  * get_drop_count() suspends interrupts to read its 16 bit counter.
+  *
+  * @copyright Copyright 2025 Ralf Sondershaus
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  */
+
+#ifndef UTIL_SPSC_QUEUE_H
+#define UTIL_SPSC_QUEUE_H
+
+#include <Std_Types.h>
+#include <OS_Type.h> // SuspendAllInterrupts(), ResumeAllInterrupts()
+
+namespace util
+{
+  // ---------------------------------------------------
+  /// What spsc_queue::push() does if the queue is full
+  // ---------------------------------------------------
+  typedef enum
+  {
+    SPSC_DROP_NEWEST = 0,   ///< the new element is dropped
+    SPSC_DROP_OLDEST = 1    ///< the oldest element is dropped, unless the consumer is reading it
+  } tSpscDropPolicy;
+
+  // ---------------------------------------------------
+  /**
+   * @brief A lock-free FIFO for exactly one producer and exactly one consumer.
+   *
+   * One slot of the buffer is kept free to distinguish between full and empty, so the
+   * queue stores up to N - 1 elements.
+   *
+   * Producer side (e.g. ISR):
+   * - push()
+   * - back_slot(), commit()
+   *
+   * Consumer side (e.g. main loop):
+   * - front()
+   * - pop()
+   * - release()
+   * - empty()
+   * - size()
+   * - get_drop_count()
+   *
+   * With SPSC_DROP_OLDEST, the producer drops the oldest element by incrementing its own 
+   * counter `dropped`; the first element is at index tail + dropped. The consumer announces
+   * with `holding` that it is reading the first element (from front() until pop()). During
+   * that time, the producer drops the new element instead. Therefore, every front() shall be
+   * followed by pop(), or by release() if the consumer keeps the element in the queue;
+   * otherwise SPSC_DROP_OLDEST behaves like SPSC_DROP_NEWEST.
+   *
+   * @tparam T      The type of the stored elements.
+   * @tparam N      Number of slots; power of two in [2, 256].
+   * @tparam Policy What push() does if the queue is full.
+   */
+  template<class T, size_t N, tSpscDropPolicy Policy = SPSC_DROP_NEWEST>
+  class spsc_queue
+  {
+  public:
+    /// value type
+    using value_type = T;
+    /// reference type
+    using reference = T&;
+    using const_reference = const T&;
+    /// size type; single byte so that index access is atomic on 8-bit targets
+    using size_type = uint8;
+
+    static_assert((N >= 2U) && (N <= 256U), "spsc_queue: N must be in [2, 256]");
+    static_assert((N & (N - 1U)) == 0U, "spsc_queue: N must be a power of two");
+
+    /// Maximal number of elements that can be stored
+    static constexpr size_type MaxSize = static_cast<size_type>(N - 1U);
+
+  protected:
+    /// Mask to wrap indices
+    static constexpr size_type kMask = static_cast<size_type>(N - 1U);
+
+    /// stored elements
+    T buffer[N];
+    /// Index of the next slot to be written. Written by the producer only.
+    volatile size_type head;
+    /// Index of the next slot to be read (without elements dropped by the producer). Written by the consumer only.
+    volatile size_type tail;
+    /// Number of oldest elements dropped by the producer (SPSC_DROP_OLDEST); wraps around. Written by the producer only.
+    volatile size_type dropped;
+    /// True while the consumer reads the first element. Written by the consumer only.
+    volatile bool holding;
+    /// Maximal number of elements since construction. Written by the producer only.
+    volatile size_type high_watermark;
+    /// Number of dropped elements (new or oldest); can overflow. Written by the producer only.
+    volatile uint16 drop_count;
+
+    /// Return the index that follows idx
+    static constexpr size_type next(size_type idx) noexcept { return static_cast<size_type>((idx + 1U) & kMask); }
+
+    /// Return the index of the first element
+    size_type first() const noexcept { return static_cast<size_type>((tail + dropped) & kMask); }
+
+  public:
+    /// Constructor
+    spsc_queue() : head{0}, tail{0}, dropped{0}, holding{false}, high_watermark{0}, drop_count{0} {}
+
+    /// Producer: return the free slot that the next push() or commit() publishes. The producer
+    /// may construct the element in place and publish it with commit() without a copy. The slot
+    /// is owned by the producer until commit() succeeds.
+    reference back_slot() noexcept { return buffer[head]; }
+
+    /// Producer: publish the element in back_slot(). If the queue is full, an element is dropped
+    /// according to Policy. Returns false if an element (the new or the oldest one) was dropped.
+    bool commit() noexcept
+    {
+      bool ret = true;
+      const size_type h_next = next(head);
+      if (h_next == first())
+      {
+        ret = false;
+        drop_count = static_cast<uint16>(drop_count + 1U);
+        if ((Policy == SPSC_DROP_NEWEST) || holding)
+        {
+          return ret;
+        }
+        // release the slot of the oldest element; it becomes the next back_slot()
+        dropped = static_cast<size_type>(dropped + 1U);
+      }
+      // the element shall be complete before it is published to the consumer
+      COMPILER_BARRIER();
+      head = h_next;
+      const size_type n = static_cast<size_type>((h_next - first()) & kMask);
+      if (n > high_watermark)
+      {
+        high_watermark = n;
+      }
+      return ret;
+    }
+
+    /// Producer: add an element to the end. If the queue is full, an element is dropped according
+    /// to Policy. Returns false if an element (val or the oldest element) was dropped.
+    bool push(const_reference val) noexcept
+    {
+      // the slot at head is always free (one slot is kept free)
+      buffer[head] = val;
+      return commit();
+    }
+
+    /// Consumer: return reference to the first element. Queue shall not be empty. The reference
+    /// is valid until pop() or release(); one of them shall follow.
+    /// The barrier keeps the compiler from reading the element before empty() was evaluated.
+    reference front() noexcept { holding = true; COMPILER_BARRIER(); return buffer[first()]; }
+
+    /// Consumer: remove the first element. Queue shall not be empty.
+    void pop() noexcept
+    {
+      holding = true;
+      // the element shall be read completely before its slot is released to the producer
+      COMPILER_BARRIER();
+      tail = static_cast<size_type>(tail + 1U);
+      COMPILER_BARRIER();
+      holding = false;
+    }
+
+    /// Consumer: end reading the first element without removing it (see front()). The reference
+    /// returned by front() becomes invalid because the producer may drop the element.
+    void release() noexcept
+    {
+      COMPILER_BARRIER();
+      holding = false;
+    }
+
+    /// Consumer: copy the first element into val and remove it. Returns false if the queue is empty.
+    bool pop(reference val) noexcept
+    {
+      if (empty())
+      {
+        return false;
+      }
+      val = front();
+      pop();
+      return true;
+    }
+
+    /// Returns true if the queue is empty
+    bool empty() const noexcept
+    {
+      // read head before first(): a drop in between is seen as one element less, never as empty
+      const size_type h = head;
+      return h == first();
+    }
+    /// Returns true if the queue is full
+    bool full() const noexcept
+    {
+      const size_type h = head;
+      return next(h) == first();
+    }
+    /// Returns the number of elements
+    size_type size() const noexcept
+    {
+      const size_type h = head;
+      return static_cast<size_type>((h - first()) & kMask);
+    }
+    /// Returns the maximal number of elements
+    static constexpr size_type max_size() noexcept { return MaxSize; }
+
+    /// Returns the maximal number of elements that were stored at the same time
+    size_type get_high_watermark() const noexcept { return high_watermark; }
+    /// Consumer: returns the number of dropped elements. Can overflow. The producer writes the
+    /// counter with two bytes on 8-bit targets, so it is read with interrupts suspended.
+    uint16 get_drop_count() const noexcept
+    {
+      SuspendAllInterrupts();
+      const uint16 count = drop_count;
+      ResumeAllInterrupts();
+      return count;
+    }
+  };
+
+} // namespace util
+
+#endif // UTIL_SPSC_QUEUE_H
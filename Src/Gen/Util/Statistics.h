@@ -0,0 +1,161 @@
+/**
+  * @file Statistics.h
+  *
+  * @author Ralf Sondershaus
+  *
+  * @brief Defines a class to collect minimum, average, maximum and a histogram of samples
+  *
+  * @copyright Copyright 2025 Ralf Sondershaus
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  */
+
+#ifndef UTIL_STATISTICS_H_
+#define UTIL_STATISTICS_H_
+
+#include <Std_Types.h>
+#include <Platform_Limits.h>
+
+namespace util
+{
+  // ------------------------------------------------------------------------------
+  /// Collects the number of samples, minimum, average and maximum of uint32 samples
+  /// (such as latencies in microseconds) and a histogram with logarithmic bins.
+  ///
+  /// Bin 0 counts samples below FirstBinLimit, bin i counts samples below
+  /// FirstBinLimit << i, and the last bin counts all larger samples:
+  ///
+  ///     bin   0        1          2                 NrBins-1
+  ///         |----|--------|----------------| ... |---------->
+  ///         0  limit   2*limit          4*limit
+  ///
+  /// The average is calculated from a sum of the samples. If the sum would
+  /// overflow, the number of samples for the average is halved and the sum is
+  /// recalculated from the average, so the average keeps following the samples.
+  ///
+  /// The values can be copied into an array of uint32 (see copy_to()), e.g. to
+  /// publish them on an RTE port.
+  ///
+  /// @tparam NrBins        Number of histogram bins [2 ... 32]
+  /// @tparam FirstBinLimit Upper limit (exclusive) of the first bin, a power of 2
+  // ------------------------------------------------------------------------------
+  template<int NrBins = 8, uint32 FirstBinLimit = 1024U>
+  class statistics
+  {
+  public:
+    static_assert((NrBins > 1) && (NrBins <= 32), "statistics: NrBins must be in [2, 32]");
+    static_assert((FirstBinLimit > 0U) && ((FirstBinLimit & (FirstBinLimit - 1U)) == 0U), "statistics: FirstBinLimit must be a power of 2");
+
+    /// Index of the values in an array (see copy_to())
+    enum : uint8
+    {
+      kCount    = 0,  ///< Number of samples (saturates)
+      kMin      = 1,  ///< Minimal sample
+      kAvg      = 2,  ///< Average of the samples
+      kMax      = 3,  ///< Maximal sample
+      kFirstBin = 4   ///< Number of samples in bin 0; bin i is at kFirstBin + i
+    };
+
+    /// Number of values in an array (see copy_to())
+    static constexpr int kNrValues = kFirstBin + NrBins;
+
+  protected:
+    uint32 count;
+    uint32 min_value;
+    uint32 max_value;
+    /// Sum and number of samples for the average
+    uint32 sum;
+    uint32 sum_count;
+    uint32 bins[NrBins];
+
+    /// Returns the bin for sample s
+    static int bin_index(uint32 s) noexcept
+    {
+      int i = 0;
+      uint32 limit = FirstBinLimit;
+      while ((i < NrBins - 1) && (s >= limit))
+      {
+        limit <<= 1U;
+        i++;
+      }
+      return i;
+    }
+
+  public:
+    /// Construct without samples
+    statistics() { clear(); }
+
+    /// Remove all samples
+    void clear() noexcept
+    {
+      count = 0U;
+      min_value = platform::numeric_limits<uint32>::max_();
+      max_value = 0U;
+      sum = 0U;
+      sum_count = 0U;
+      for (int i = 0; i < NrBins; i++)
+      {
+        bins[i] = 0U;
+      }
+    }
+
+    /// Add sample s
+    void add(uint32 s) noexcept
+    {
+      if (count < platform::numeric_limits<uint32>::max_())
+      {
+        count++;
+      }
+      if (s < min_value)
+      {
+        min_value = s;
+      }
+      if (s > max_value)
+      {
+        max_value = s;
+      }
+      while (s > platform::numeric_limits<uint32>::max_() - sum)
+      {
+        // keep the average but halve the weight of the previous samples
+        const uint32 avg = sum / sum_count;
+        sum_count >>= 1U;
+        sum = avg * sum_count;
+      }
+      sum += s;
+      sum_count++;
+      uint32& bin = bins[bin_index(s)];
+      if (bin < platform::numeric_limits<uint32>::max_())
+      {
+        bin++;
+      }
+    }
+
+    /// Returns the number of samples (saturates)
+    uint32 get_count() const noexcept { return count; }
+    /// Returns the minimal sample, or 0 if there are no samples
+    uint32 get_min() const noexcept { return (count > 0U) ? min_value : 0U; }
+    /// Returns the maximal sample, or 0 if there are no samples
+    uint32 get_max() const noexcept { return max_value; }
+    /// Returns the average of the samples, or 0 if there are no samples
+    uint32 get_avg() const noexcept { return (sum_count > 0U) ? sum / sum_count : 0U; }
+    /// Returns the number of samples in bin i [0 ... NrBins-1]. No bounds checking is performed.
+    uint32 get_bin(int i) const noexcept { return bins[i]; }
+
+    /// Copy the values into array arr with at least kNrValues elements of type uint32
+    template<class Array>
+    void copy_to(Array& arr) const noexcept
+    {
+      static_assert(sizeof(arr[0]) == sizeof(uint32), "statistics: array elements must be uint32");
+      arr[kCount] = get_count();
+      arr[kMin] = get_min();
+      arr[kAvg] = get_avg();
+      arr[kMax] = get_max();
+      for (int i = 0; i < NrBins; i++)
+      {
+        arr[kFirstBin + i] = bins[i];
+      }
+    }
+  };
+} // namespace util
+
+#endif // UTIL_STATISTICS_H_
@@ -74,7 +74,14 @@ namespace util
     /// Return true if timer is elapsed; false otherwise.
     /// micros() >= ulTimer: positive result: highest bit is 0
     /// micros() <  ulTimer: negative result: highest bit is 1
-    bool timeout() const { return ((static_cast<time_type>(getCurrentTime() - ulTimer)) & static_cast<time_type>(0x80000000u)) == static_cast<time_type>(0u); }
+    bool timeout() const { return timeout(getCurrentTime()); }
+
+    /// Return true if timer is elapsed at time ulNow [us]; false otherwise.
+    /// Use this variant to check multiple timers with one call of micros().
+    bool timeout(const time_type ulNow) const noexcept { return ((static_cast<time_type>(ulNow - ulTimer)) & static_cast<time_type>(0x80000000u)) == static_cast<time_type>(0u); }
+
+    /// Return the time stamp of the timeout [us]
+    time_type getTimer() const noexcept { return ulTimer; }
 
     /// Return current time [us]
     static time_type getCurrentTime(void) { return hal::micros(); }
@@ -155,6 +155,10 @@ void loop()
     static util::MilliTimer LedTimer;
     static util::MilliTimer DccTimer;
     static uint32 last_fifo_size = 0;
+
+    // decode edges as often as possible to keep the edge ring short (deferred mode)
+    dcc::decoder::get_instance().process_edges();
+
     // alive LED
     if (LedTimer.timeout())
     {
@@ -169,10 +173,18 @@ void loop()
         hal::serial::print(dcc::decoder::get_instance().get_zeros_count());
         hal::serial::print(" inv=");
         hal::serial::print(dcc::decoder::get_instance().get_invalids_count());
+        hal::serial::print(" cs_err=");
+        hal::serial::print(dcc::decoder::get_instance().get_checksum_errors_count());
         hal::serial::print(" pkt=");
         hal::serial::print(dcc::decoder::get_instance().get_packet_count());
         hal::serial::print(" fifo=");
-        hal::serial::println(last_fifo_size);
+        hal::serial::print(last_fifo_size);
+        hal::serial::print(" fifo_hwm=");
+        hal::serial::print(static_cast<uint32>(dcc::decoder::get_instance().get_fifo_high_watermark()));
+        hal::serial::print(" fifo_drop=");
+        hal::serial::print(dcc::decoder::get_instance().get_fifo_drop_count());
+        hal::serial::print(" edge_ovr=");
+        hal::serial::println(dcc::decoder::get_instance().get_edge_overrun_count());
     }
 
     if (DccTimer.timeout())
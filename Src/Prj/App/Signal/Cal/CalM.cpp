@@ -108,7 +108,7 @@ namespace cal
     /**
      * @brief Construct a new CalM object
      */
-    CalM::CalM()
+    CalM::CalM() : staged_since_cycle(false), commit_deferrals(0U)
     {
     }
 
@@ -229,13 +229,29 @@ namespace cal
 
     /**
      * @brief Save a CV to EEPROM if a value differs from the value already stored in the EEPROM.
-     *
-     * @return true Validation successful
-     * @return false Validation failed
+     * Clears the staged state of the CV.
      */
     void CalM::update(uint16 cv_id)
     {
         hal::eeprom::update(static_cast<int>(cv_id), eeprom_data_buffer[cv_id]);
+        pending_cvs.reset(cv_id);
+    }
+
+    /**
+     * @brief Write staged CVs to EEPROM in the order of their CV IDs.
+     * 
+     * @param max_nr Maximal number of CVs to be written
+     */
+    void CalM::commit(uint16 max_nr)
+    {
+        for (uint16 cv_id = 0U; (max_nr > 0U) && (cv_id < eeprom::kSizeOfData); cv_id++)
+        {
+            if (pending_cvs.test(cv_id))
+            {
+                update(cv_id);
+                max_nr--;
+            }
+        }
     }
 
     /**
@@ -263,10 +279,25 @@ namespace cal
      * 
      * Cycle function called every 100 ms.
      * 
-     * @note currently empty
+     * Writes staged CVs (see stage_cv()) to EEPROM, at most kMaxCommitsPerCycle per call. While
+     * CVs are still staged (burst of CV writes), the commit is deferred for at most 
+     * kMaxCommitDeferrals calls so that repeated writes to the same CV are coalesced.
      */
     void CalM::cycle100()
     {
+        if (is_commit_pending())
+        {
+            if (staged_since_cycle && (commit_deferrals < kMaxCommitDeferrals))
+            {
+                commit_deferrals++;
+            }
+            else
+            {
+                commit_deferrals = 0U;
+                commit(kMaxCommitsPerCycle);
+            }
+        }
+        staged_since_cycle = false;
     }
 
     void CalM::get_signal_aspect(uint8 signal_id, uint8 cmd, ::signal::signal_aspect& aspect)
@@ -20,6 +20,7 @@
 #include <Cal/CalM_config.h>
 #include <Hal/Gpio.h>
 #include <Util/Array.h>
+#include <Util/bitset.h>
 
 namespace cal
 {
@@ -45,9 +46,36 @@ namespace cal
          * Each pin's mode is set using the Arduino pinMode function.
          */
         static hal::GpioConfig gpio_cfg;
+
+        /**
+         * @brief Maximal number of CVs that cycle100() writes to EEPROM per call. A write takes 
+         * about 3.3 ms per byte on AVR.
+         */
+        static constexpr uint8 kMaxCommitsPerCycle = 2U;
+
+        /**
+         * @brief Maximal number of calls of cycle100() that a commit is deferred while CVs are 
+         * still staged (burst of CV writes).
+         */
+        static constexpr uint8 kMaxCommitDeferrals = 10U;
         
     protected:
 
+        /**
+         * @brief One bit per CV that has been staged (see stage_cv()) but not written to EEPROM yet
+         */
+        util::bitset<uint8, eeprom::kSizeOfData> pending_cvs;
+
+        /**
+         * @brief True if a CV has been staged since the last call of cycle100()
+         */
+        bool staged_since_cycle;
+
+        /**
+         * @brief Number of calls of cycle100() that the commit has been deferred
+         */
+        uint8 commit_deferrals;
+
         /**
          * @brief Structure to hold signal aspect information for external take-over
          */
@@ -136,12 +164,30 @@ namespace cal
         }
 
         /**
-         * @brief Set a CV if CV ID is valid.
+         * @brief Set a CV if CV ID is valid and write it to EEPROM immediately.
          * 
          * @param cv_id [in] CV ID
          * @param val [in] CV value
          */
         void set_cv(uint16 cv_id, uint8 val)
+        {
+            if (stage_cv(cv_id, val))
+            {
+                // save to EEPROM
+                update(cv_id);
+            }
+        }
+
+        /**
+         * @brief Set a CV in the RAM buffer if CV ID is valid. The CV is written to EEPROM by 
+         * cycle100() (see kMaxCommitsPerCycle), so a burst of CV writes (e.g. DCC programming)
+         * does not block the cyclic runables. Repeated writes to the same CV are written once.
+         * 
+         * @param cv_id [in] CV ID
+         * @param val [in] CV value
+         * @return true CV ID is valid
+         */
+        bool stage_cv(uint16 cv_id, uint8 val)
         {
             if (is_cv_id_valid(cv_id))
             {
@@ -168,11 +214,25 @@ namespace cal
                 {
                     // no action required
                 }
-                // save to EEPROM
-                update(cv_id);
+                pending_cvs.set(cv_id);
+                staged_since_cycle = true;
+                return true;
             }
+            return false;
         }
 
+        /**
+         * @brief Returns true if staged CVs are not written to EEPROM yet
+         */
+        bool is_commit_pending() const noexcept { return pending_cvs.any(); }
+
+        /**
+         * @brief Write staged CVs to EEPROM.
+         * 
+         * @param max_nr Maximal number of CVs to be written
+         */
+        void commit(uint16 max_nr);
+
         /**
          * @defgroup EEPROM access
          * @{
@@ -210,9 +270,7 @@ namespace cal
         bool update();
         /**
          * @brief Save a CV to EEPROM if a value differs from the value already stored in the EEPROM.
-         *
-         * @return true Validation successful
-         * @return false Validation failed
+         * Clears the staged state of the CV.
          */
         void update(uint16 cv_id);
         /** @} */
@@ -741,6 +741,7 @@ namespace com
     {
         static size_t outputPortListIdx = 0;
         util::basic_string<4, char> tmp;
+        char name[rte::kMaxLenPortName + 1U];
         bool ret;
 
         if (outputPortListIdx < rte::getNrPorts())
@@ -749,7 +750,8 @@ namespace com
             response.clear();
             response.append(tmp);
             response.append(" : ");
-            response.append(rte::getPortData(outputPortListIdx)->szName);
+            ROM_READ_STRING(name, rte::getPortData(outputPortListIdx)->szName);
+            response.append(name);
             outputPortListIdx++;
         }
         if (outputPortListIdx < rte::getNrPorts())
@@ -788,6 +790,7 @@ namespace com
         bool ret;
         size_t i;
         util::basic_string<11, char> tmp;
+        char name[rte::kMaxLenPortName + 1U];
 
         if (pm.timer.timeout())
         {
@@ -795,7 +798,8 @@ namespace com
             response.clear();
             util::to_string(hal::micros(), tmp);
             response.append("[").append(tmp).append(" us] ");
-            response.append(pm.pPortData->szName);
+            ROM_READ_STRING(name, pm.pPortData->szName);
+            response.append(name);
             response.append(":");
             for (i = portMonitor.unFirstIdx; i < portMonitor.unFirstIdx + portMonitor.unNrIdx; i++)
             {
@@ -832,18 +836,18 @@ namespace com
     // -----------------------------------------------------------------------------------
     static ret_type process_monitor_start(stringstream_type &st, string_type &response)
     {
-        char ifc_name[32];
+        char ifc_name[rte::kMaxLenPortName + 1U];
         uint16 unCycleTime;
         uint16 unFirstIdx;
         uint16 unNrIdx;
         ret_type ret;
-        st >> unCycleTime >> ifc_name;
+        st >> unCycleTime >> util::setw(sizeof(ifc_name)) >> ifc_name;
         if (!st.fail())
         {
             const rte::port_data_t *pPortData = rte::getPortData(ifc_name);
             if (pPortData)
             {
-                response.append(pPortData->szName);
+                response.append(ifc_name);
                 portMonitor.pPortData = pPortData;
                 portMonitor.unCycleTime = unCycleTime;
                 portMonitor.timer.start(unCycleTime);
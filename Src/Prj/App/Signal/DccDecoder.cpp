@@ -78,6 +78,31 @@ namespace signal
         return false;
     }
 
+    /**
+     * @brief Write a command to the RTE. Precondition: pos is within boundaries.
+     * 
+     * With CFG_DCC_DECODER_TIMESTAMP, the time stamp of the packet is written to the RTE if the
+     * command changes, so that the latency from DCC packet to output can be measured.
+     * 
+     * @param pos Position on RTE
+     * @param cmd The command
+     * @param dcc_cmd The decoded DCC packet that carries the command
+     */
+    static void write_command(uint16 pos, uint8 cmd, const dcc::decoder::command_type& dcc_cmd)
+    {
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+        uint8 cmd_old;
+        rte::ifc_dcc_commands::readElement(pos, cmd_old);
+        if (cmd != cmd_old)
+        {
+            rte::ifc_dcc_timestamps::writeElement(pos, dcc_cmd.get_timestamp());
+        }
+#else
+        (void) dcc_cmd;
+#endif
+        rte::ifc_dcc_commands::writeElement(pos, cmd);
+    }
+
     /**
      * @brief Handles the reception of basic DCC packets.
      * 
@@ -98,12 +123,12 @@ namespace signal
      * - first_output_address + 2 G = command 5
      * - ...
      * 
-     * @param pkt Reference to the received DCC packet
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      */
-    void DccDecoder::basic_packet_received(packet_type& pkt)
+    void DccDecoder::basic_packet_received(const command_type& dcc_cmd)
     {
-        // The pass filter owns a copy of CV29 from the decoder configuration data.
-        const uint16 pkt_address = pkt.get_address(get_cv29());
+        // The address was decoded with CV29 of the address filter when the packet was received.
+        const uint16 pkt_address = dcc_cmd.get_address();
         if (pkt_address >= get_first_output_address())
         {
             // pair index
@@ -114,7 +139,7 @@ namespace signal
             // and position on RTE
             const uint16 pos = (pkt_address - get_first_output_address()) / cfg::kNrDccAddressesPerSignal;
             // command: 0 = 1R, 1 = 1G, 2 = 2R, 3 = 2G, ...
-            const uint8 cmd = static_cast<uint8>(2U*idx + pkt.ba_get_output_direction());
+            const uint8 cmd = static_cast<uint8>(2U*idx + dcc_cmd.ba_get_output_direction());
             hal::serial::print("Basic Accessory Packet received: addr=");
             hal::serial::print(pkt_address);
             hal::serial::print(" pos=");
@@ -123,7 +148,7 @@ namespace signal
             hal::serial::print(static_cast<int>(cmd));
             if (rte::ifc_dcc_commands::boundaryCheck(pos))
             {
-                rte::ifc_dcc_commands::writeElement(pos, cmd);
+                write_command(pos, cmd, dcc_cmd);
                 hal::serial::print(" update RTE");
             }
             hal::serial::println();
@@ -137,18 +162,18 @@ namespace signal
      * The position on RTE is calculated from the DCC address of the packet minus the first output
      * address.
      * 
-     * @param pkt Reference to the received DCC packet
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      */
-    void DccDecoder::extended_packet_received(packet_type& pkt)
+    void DccDecoder::extended_packet_received(const command_type& dcc_cmd)
     {
-        const uint16 pos = pkt.get_address(get_cv29()) - get_first_output_address();
+        const uint16 pos = dcc_cmd.get_address() - get_first_output_address();
         hal::serial::print("Extended Accessory Packet received: addr=");
-        hal::serial::println(pkt.get_address(get_cv29()));
+        hal::serial::println(dcc_cmd.get_address());
         hal::serial::print(" pos=");
         hal::serial::println(static_cast<int>(pos));
         if (rte::ifc_dcc_commands::boundaryCheck(pos))
         {
-            rte::ifc_dcc_commands::writeElement(pos, pkt.ea_get_aspect());
+            write_command(pos, dcc_cmd.ea_get_aspect(), dcc_cmd);
         }
     }
 
@@ -160,26 +185,25 @@ namespace signal
      * The position on RTE is calculated from the DCC address of the packet minus the first output 
      * address.
      * 
-     * @param pkt Reference to the received DCC packet
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      * 
      * @details For basic accessory packets, forwards the output direction.
      *          For extended accessory packets, forwards the aspect value.
      *          Toggles an LED pin after processing to indicate activity.
      *          Ignores packets if the calculated position is out of bounds.
      * 
-     * @note The address calculation depends on CV29 configuration stored in pass_filter
+     * @note The address calculation depends on CV29 configuration stored in the address filter
      */
-    void DccDecoder::packet_received(packet_type &pkt)
+    void DccDecoder::packet_received(const command_type &dcc_cmd)
     {
         using pkt_enum_type = packet_type::packet_type;
-        // TBD could be improved by defining sub classes for packet_type
-        switch (pkt.get_type())
+        switch (dcc_cmd.get_type())
         {
         case pkt_enum_type::BasicAccessory:
-            basic_packet_received(pkt);
+            basic_packet_received(dcc_cmd);
             break;
         case pkt_enum_type::ExtendedAccessory:
-            extended_packet_received(pkt);
+            extended_packet_received(dcc_cmd);
             break;
         default:
             break;
@@ -188,6 +212,87 @@ namespace signal
         toggle_led_pin();
     }
 
+    /**
+     * @brief Handles CV access instructions and reset packets.
+     * 
+     * Operations mode instructions are executed for the addresses of the decoder only. Service
+     * mode instructions carry no address; dcc::cv_programming executes them in service mode only.
+     * 
+     * A verify that matches and a write in service mode are acknowledged. The board has no
+     * circuit for the acknowledge current pulse (service mode) or RailCom (operations mode), so
+     * the acknowledge is printed.
+     * 
+     * @param dcc_cmd Reference to the received and decoded DCC packet
+     */
+    void DccDecoder::program(const command_type& dcc_cmd)
+    {
+        if (dcc_cmd.is_cv_access() && !dcc_cmd.is_service_mode() && !get_filter().test(dcc_cmd.get_address()))
+        {
+            return;
+        }
+        programming_type::request_type req;
+        if (programming.execute(dcc_cmd, req) && rte::is_cv_id_valid(req.cv))
+        {
+            const uint8 cv_value = rte::get_cv(req.cv);
+            bool ack;
+            if (req.is_write())
+            {
+                (void) rte::stage_cv(req.cv, req.apply(cv_value));
+                ack = req.service_mode;
+            }
+            else
+            {
+                ack = req.verify(cv_value);
+            }
+            hal::serial::print("CV access: cv=");
+            hal::serial::print(req.cv);
+            hal::serial::print(" op=");
+            hal::serial::print(static_cast<int>(req.operation));
+            hal::serial::print(" data=");
+            hal::serial::print(static_cast<int>(req.data));
+            hal::serial::println(ack ? " ACK" : "");
+        }
+    }
+
+    // --------------------------------------------------------------------------
+    /// @brief Set the address filter to the addresses of the decoder
+    // --------------------------------------------------------------------------
+    void DccDecoder::set_filter()
+    {
+        filter_type &filter = get_filter();
+        filter.clear();
+        filter.set_cv29(signal_cal::get_cv29());
+        filter.set_range(first_output_address, first_output_address + cfg::kNrAddresses);
+        // reset packets, and service mode instructions in service mode
+        filter.enable_service_mode(true);
+    }
+
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+    // --------------------------------------------------------------------------
+    /// @brief Take the histogram of the decoder and write it and the signal quality metrics to 
+    /// the RTE. The measurement window is the time since the last call.
+    // --------------------------------------------------------------------------
+    void DccDecoder::write_signal_quality()
+    {
+        using histogram_type = dcc::decoder::halfbit_histogram_type;
+        histogram_type::counters_type counters;
+        rte::dcc_halfbit_histogram_array bins;
+        rte::dcc_signal_quality_array metrics;
+
+        const util::MilliTimer::time_type window_ms = quality_timer.getTimeSince() + kSignalQualityPeriod_ms;
+        dcc::decoder::get_instance().get_halfbit_histogram().take(counters);
+        quality_timer.start(kSignalQualityPeriod_ms);
+
+        for (size_t i = 0; i < bins.size(); i++)
+        {
+            bins[i] = counters.bins[i];
+        }
+        histogram_type::evaluate(counters, window_ms, metrics);
+        rte::ifc_dcc_halfbit_histogram::write(bins);
+        rte::ifc_dcc_signal_quality::write(metrics);
+    }
+#endif
+
     // --------------------------------------------------------------------------
     /// @brief Init after power on
     // --------------------------------------------------------------------------
@@ -198,10 +303,12 @@ namespace signal
         dcc::decoder::get_instance().init(kIntPin);
 
         first_output_address = signal_cal::calc_output_address();
-        pass_accessory_filter.set_lo(first_output_address);
-        pass_accessory_filter.set_hi(first_output_address + cfg::kNrAddresses);
-        pass_accessory_filter.set_cv29(signal_cal::get_cv29());
-        dcc::decoder::get_instance().set_filter(pass_accessory_filter);
+        set_filter();
+        dcc::decoder::get_instance().set_repeat_filter(repeat_filter);
+        dcc::decoder::get_instance().set_packet_notification(&DccDecoder::notify_packet);
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+        quality_timer.start(kSignalQualityPeriod_ms);
+#endif
     }
 
     // --------------------------------------------------------------------------
@@ -213,16 +320,15 @@ namespace signal
         // recalculate address because coding data might have changed.
         // TBD: Can be optimized if CalM informs about coding data changes or 
         // if DCC address is publicly available.
-        first_output_address = signal_cal::calc_output_address();
-        if ((pass_accessory_filter.get_lo() != first_output_address) ||
-            (pass_accessory_filter.get_hi() != (first_output_address + cfg::kNrAddresses)) ||
-            (pass_accessory_filter.get_cv29() != signal_cal::get_cv29()))
+        const uint16 output_address = signal_cal::calc_output_address();
+        if ((output_address != first_output_address) ||
+            (get_cv29() != signal_cal::get_cv29()))
         {
             hal::serial::println("Update filter");
-            pass_accessory_filter.set_lo(first_output_address);
-            pass_accessory_filter.set_hi(first_output_address + cfg::kNrAddresses);
-            pass_accessory_filter.set_cv29(signal_cal::get_cv29());
-            dec.set_filter(pass_accessory_filter);
+            first_output_address = output_address;
+            set_filter();
+            // cleared by the decoder (ISR) with the next packet
+            repeat_filter.clear();
         }
 
         if (dec.is_fifo_overflow())
@@ -230,21 +336,13 @@ namespace signal
             hal::serial::println("FIFO OVERFLOW");
         }
 
-        dec.fetch();
-        while (!dec.empty())
+        packet_event();
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+        if (quality_timer.timeout())
         {
-            packet_type &pkt = dec.front();
-            hal::serial::print("Packet type=");
-            hal::serial::print(static_cast<uint8>(pkt.get_type()));
-            hal::serial::print(" Packet address=");
-            hal::serial::println(pkt.get_address(get_cv29()));
-            if (pass_accessory_filter.do_filter(pkt))
-            {
-                packet_received(pkt);
-            }
-
-            dcc::decoder::get_instance().pop();
+            write_signal_quality();
         }
+#endif
         if (toggle_led_pin(kBlinkLedPeriodValid_ms))
         {
 #if 0
@@ -259,4 +357,42 @@ namespace signal
         }
     }
 
+    // --------------------------------------------------------------------------
+    /// Called by the decoder from the ISR (ISR mode) or from process_edges() (deferred mode)
+    // --------------------------------------------------------------------------
+    void DccDecoder::notify_packet()
+    {
+        rte::setEvent(rte::kEvent_dcc_packet);
+    }
+
+    // --------------------------------------------------------------------------
+    /// Event runable and called by cycle(). Fetches new packets and handles them.
+    // --------------------------------------------------------------------------
+    void DccDecoder::packet_event()
+    {
+        dcc::decoder &dec = dcc::decoder::get_instance();
+
+        // deferred mode: decode the edges that the ISR has stored since the last call
+        dec.process_edges();
+        dec.fetch();
+        while (!dec.empty())
+        {
+            // decoded once when the packet was received
+            const command_type &dcc_cmd = dec.front();
+            hal::serial::print("Packet type=");
+            hal::serial::print(static_cast<uint8>(dcc_cmd.get_type()));
+            hal::serial::print(" Packet address=");
+            hal::serial::println(dcc_cmd.get_address());
+            // CV access instructions, reset packets; other packets end service mode
+            program(dcc_cmd);
+            // the addresses of the filter might have changed since the packet was received
+            if (!dcc_cmd.is_cv_access() && !dcc_cmd.is_reset() && get_filter().test(dcc_cmd.get_address()))
+            {
+                packet_received(dcc_cmd);
+            }
+
+            dec.pop();
+        }
+    }
+
 } // namespace signal
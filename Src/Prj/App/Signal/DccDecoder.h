@@ -12,27 +12,36 @@
 #define PRJ_DCC_DECODER_H_
 
 #include <Dcc/Decoder.h>
-#include <Dcc/Filter.h>
+#include <Dcc/RepeatFilter.h>
+#include <Dcc/CvProgramming.h>
 #include <Rte/Rte_Types.h>
 #include <Util/Array.h>
 #include <Util/Timer.h>
 #include <Cal/CalM_Types.h>
 
+#if CFG_DCC_DECODER_ADDRESS_FILTER != OPT_DCC_DECODER_ADDRESS_FILTER_ACCESSORY
+#error "Signal requires CFG_DCC_DECODER_ADDRESS_FILTER == OPT_DCC_DECODER_ADDRESS_FILTER_ACCESSORY"
+#endif
+#if CFG_DCC_DECODER_DECODED_COMMAND != OPT_DCC_DECODER_DECODED_COMMAND_ON
+#error "Signal requires CFG_DCC_DECODER_DECODED_COMMAND == OPT_DCC_DECODER_DECODED_COMMAND_ON"
+#endif
+
 namespace signal
 {
   class DccDecoder
   {
   protected:
     using packet_type = dcc::decoder::packet_type;
-    using filter_type = dcc::pass_accessory_address_filter<packet_type>;
+    using command_type = dcc::decoder::command_type;
+    using filter_type = dcc::decoder::address_filter_type;
+    using repeat_filter_type = dcc::repeat_filter<packet_type>;
+    using programming_type = dcc::cv_programming<command_type>;
 
     /**
-     * @brief The address filter for the decoder. Only packets that pass this filter are stored 
-     * in the FIFO buffer.
-     * @note The filter owns a copy of CV29 from the decoder configuration data so DccDecoder does
-     * not need to store its own copy of CV29.
+     * @brief Suppresses repetitions of packets that passed the address filter so that they
+     * do not occupy the FIFO buffer.
      */
-    filter_type pass_accessory_filter;
+    repeat_filter_type repeat_filter;
     /**
      * @brief The first output address of the decoder as calculated from CV1/CV9.
      * 
@@ -40,6 +49,36 @@ namespace signal
      */
     uint16 first_output_address;
 
+    /**
+     * @brief CV access instructions (operations mode and service mode).
+     */
+    programming_type programming;
+
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+    /**
+     * @brief Measurement window of the signal quality metrics.
+     */
+    util::MilliTimer quality_timer;
+
+    /**
+     * @brief Take the histogram of the decoder and write it and the signal quality metrics to the RTE.
+     */
+    void write_signal_quality();
+#endif
+
+    /**
+     * @brief Returns the address filter of the decoder. Only packets that pass this filter are 
+     * stored in the FIFO buffer.
+     * @note The filter owns a copy of CV29 from the decoder configuration data so DccDecoder does
+     * not need to store its own copy of CV29.
+     */
+    static filter_type &get_filter() noexcept { return dcc::decoder::get_instance().get_address_filter(); }
+
+    /**
+     * @brief Set the address filter to the addresses of the decoder (first_output_address and CV29).
+     */
+    void set_filter();
+
     /**
      * @brief Handles the reception of basic DCC accessory packets.
      * 
@@ -47,9 +86,9 @@ namespace signal
      * address and the output direction, and forwards the result to the RTE. The position on RTE 
      * is calculated from the DCC address of the packet minus the first output address.
      * 
-     * @param pkt Reference to the received DCC packet
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      */
-    void basic_packet_received(packet_type& pkt);
+    void basic_packet_received(const command_type& dcc_cmd);
     
     /**
      * @brief Handles the reception of extended DCC accessory packets.
@@ -58,9 +97,9 @@ namespace signal
      * The position on RTE is calculated from the DCC address of the packet minus the first output
      * address.
      * 
-     * @param pkt Reference to the received DCC packet
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      */
-    void extended_packet_received(packet_type& pkt);
+    void extended_packet_received(const command_type& dcc_cmd);
 
     /**
      * @brief Processes received DCC packets for accessory decoders.
@@ -70,10 +109,27 @@ namespace signal
      * The position on RTE is calculated from the DCC address of the packet minus the first output 
      * address.
      * 
-     * @param pkt Reference to the received DCC packet
-     * @note Can modify the packet (e.g. for addressing calculation), so pkt is not const.
+     * @param dcc_cmd Reference to the received and decoded DCC packet
      */
-    void packet_received(packet_type& pkt);
+    void packet_received(const command_type& dcc_cmd);
+
+    /**
+     * @brief Handles CV access instructions for the decoder (operations mode programming for 
+     * its addresses, service mode) and reset packets.
+     * 
+     * Writes are staged in the RAM buffer of the calibration manager and written to EEPROM by
+     * cal::CalM::cycle100(), so a burst of CV writes does not block the cyclic runables.
+     * 
+     * @param dcc_cmd Reference to the received and decoded DCC packet
+     */
+    void program(const command_type& dcc_cmd);
+
+    /**
+     * @brief Called by the decoder when a packet passed the filters (ISR or process_edges()).
+     * Sets the event of packet_event() so that the packet is processed with the next call of
+     * rte::exec().
+     */
+    static void notify_packet();
 
   public:
     /// The interrupt pin
@@ -81,16 +137,24 @@ namespace signal
     static constexpr uint8 kBlinkLedPin = 13U;
     static constexpr util::MilliTimer::time_type kBlinkLedPeriodValid_ms = 1000U;
     static constexpr util::MilliTimer::time_type kBlinkLedPeriodInvalid_ms = 500U;
+    /// Measurement window of the signal quality metrics (see dcc::halfbit_histogram)
+    static constexpr util::MilliTimer::time_type kSignalQualityPeriod_ms = 1000U;
 
     DccDecoder() = default;
 
-    uint8 get_cv29() const noexcept { return pass_accessory_filter.get_cv29(); }
+    uint8 get_cv29() const noexcept { return get_filter().get_cv29(); }
 
     /// Returns the first DCC output address of the decoder.
     uint16 get_first_output_address() const noexcept { return first_output_address; }
 
     void init();
     void cycle();
+
+    /**
+     * @brief Event runable: processes the packets in the FIFO of the decoder. Called by the RTE
+     * when the decoder has received a packet (see notify_packet()) and from cycle().
+     */
+    void packet_event();
   };
 }
 
@@ -30,7 +30,8 @@ namespace signal
   {
     classifiers.run();
 
-    rte::ifc_classified_values::write(classifiers.get_classified_values());
+    // classified values change rarely: keep the version of the port if they didn't change
+    rte::ifc_classified_values::update(classifiers.get_classified_values());
     rte::ifc_ad_values::write(classifiers.get_adc_values());
     // log.begin("AD Values ");
     // auto aADValues = classifiers.ad_values();
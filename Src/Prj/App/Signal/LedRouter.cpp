@@ -13,6 +13,9 @@
 #include <Util/Algorithm.h>
 #include <LedRouter.h>
 #include <Hal/Serial.h>
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+#include <Hal/Timer.h>
+#endif
 
 namespace signal
 {
@@ -57,7 +60,12 @@ namespace signal
     void LedRouter::doRamps()
     {
         rte::Ifc_OnboardTargetDutyCycles::size_type pos = 0U;
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+        bool latency_updated = false;
+#endif
 
+        // readers see all duty cycles of this cycle or none of them
+        rte::ifc_onboard_target_duty_cycles::beginWrite();
         for (auto it = ramps_onboard.begin(); it != ramps_onboard.end(); it++)
         {
             if (rte::sig::is_output_pin(pos))
@@ -67,9 +75,29 @@ namespace signal
                 const intensity8_255_type pwm{ROM_READ_BYTE(&aunIntensity2Pwm[intensity])};
                 rte::ifc_onboard_target_duty_cycles::writeElement(pos, pwm);
                 hal::analogWrite(pos, static_cast<int>(pwm));
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+                // the first output after a DCC command change completes a latency sample
+                uint32 timestamp;
+                rte::ifc_onboard_target_timestamps::readElement(pos, timestamp);
+                if (timestamp != 0U)
+                {
+                    latency.add(hal::micros() - timestamp);
+                    rte::ifc_onboard_target_timestamps::writeElement(pos, 0U);
+                    latency_updated = true;
+                }
+#endif
             }
             pos++;
         }
+        rte::ifc_onboard_target_duty_cycles::endWrite();
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+        if (latency_updated)
+        {
+            rte::dcc_latency_array values;
+            latency.copy_to(values);
+            rte::ifc_dcc_latency::write(values);
+        }
+#endif
     }
 
     // -----------------------------------------------------------------------------------
@@ -167,6 +195,9 @@ namespace signal
         {
             it->clear();
         }
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+        latency.clear();
+#endif
     }
 
     // -----------------------------------------------------------------------------------
@@ -41,6 +41,7 @@ namespace signal
   ///
   /// Output: RTE SR port
   /// - rte::ifc_onboard_target_duty_cycles (rte::Ifc_OnboardTargetDutyCycles)
+  /// - rte::ifc_dcc_latency (rte::Ifc_DccLatency) with CFG_DCC_DECODER_TIMESTAMP
   // -----------------------------------------------------------------------------------
   class LedRouter
   {
@@ -61,6 +62,11 @@ namespace signal
     ramp_onboard_array_type ramps_onboard;
     ramp_external_array_type ramps_external;
 
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    /// [us] Latency from DCC packet to output, published on rte::ifc_dcc_latency
+    rte::dcc_latency_statistics latency;
+#endif
+
     static constexpr uint8 kCycleTime = 10U;
 
     /// Caclulate ramps
@@ -25,6 +25,15 @@
 #define RTE_CFG_PORT_SR_AVAILABLE
 #endif
 
+// This macro is used to configure the RTE to dispatch event runables
+#ifndef RTE_CFG_EVENT_AVAILABLE
+#define RTE_CFG_EVENT_AVAILABLE
+#endif
+
+// This macro is used to configure the RTE to measure run time, release jitter and overruns of the
+// runables (port rte_profiling, e.g. MON_START 1000 rte_profiling)
+//#define RTE_CFG_PROFILING_AVAILABLE
+
 RTE_DEF_START
 
 RTE_DEF_OBJ_START
@@ -55,6 +64,10 @@ RTE_DEF_CYCLIC_RUNABLE(cal::CalM              , calm            , cycle100, 1000
 RTE_DEF_CYCLIC_RUNABLE(com::ComR              , comr            , cycle   , 800 , 10000)
 RTE_DEF_CYCLIC_RUNABLE_END
 
+RTE_DEF_EVENT_RUNABLE_START
+RTE_DEF_EVENT_RUNABLE(dcc_packet, signal::DccDecoder, dcc_decoder, packet_event)
+RTE_DEF_EVENT_RUNABLE_END
+
 RTE_DEF_PORT_SR_START
 RTE_DEF_PORT_SR(rte::Ifc_Cal_DccAddress, ifc_cal_dcc_address)
 RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_ClassifiedValues, ifc_classified_values)
@@ -62,6 +75,15 @@ RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_ADValues, ifc_ad_values)
 RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_DccCommands, ifc_dcc_commands)
 RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_OnboardTargetDutyCycles, ifc_onboard_target_duty_cycles)
 RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_ExternalTargetDutyCycles, ifc_external_target_duty_cycles)
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_DccTimestamps, ifc_dcc_timestamps)
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_OnboardTargetTimestamps, ifc_onboard_target_timestamps)
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_DccLatency, ifc_dcc_latency)
+#endif
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_DccHalfBitHistogram, ifc_dcc_halfbit_histogram)
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_DccSignalQuality, ifc_dcc_signal_quality)
+#endif
 RTE_DEF_PORT_SR_END
 
 RTE_DEF_PORT_CS_START
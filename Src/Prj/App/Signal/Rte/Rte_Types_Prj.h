@@ -16,8 +16,11 @@
 #include <Platform_Limits.h>
 #include <Prj_Types.h>
 #include <Cal/CalM_Types.h>
+#include <Dcc/DecoderCfg.h>
+#include <Dcc/HalfBitHistogram.h>
 #include <Util/Array.h>
 #include <Util/Intensity.h>
+#include <Util/Statistics.h>
 
 // forward declaration for servers
 namespace cal
@@ -62,6 +65,39 @@ namespace rte
     using Ifc_OnboardTargetDutyCycles = rte::ifc_sr_array<onboard_target_array>;
     using Ifc_ExternalTargetDutyCycles = rte::ifc_sr_array<external_target_array>;
 
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    // -----------------------------------------------------------------------------------
+    /// Latency measurement from DCC packet to output (see CFG_DCC_DECODER_TIMESTAMP).
+    /// A time stamp [us] is forwarded from the DCC packet that changes a command to the
+    /// onboard targets of the signal. A time stamp of 0 means "no time stamp".
+    // -----------------------------------------------------------------------------------
+    using dcc_timestamps_array = util::array<uint32, cfg::kNrSignals>;
+    using onboard_timestamps_array = util::array<uint32, cfg::kNrOnboardTargets>;
+    /// [us] Latency from DCC packet to output
+    using dcc_latency_statistics = util::statistics<>;
+    using dcc_latency_array = util::array<uint32, dcc_latency_statistics::kNrValues>;
+
+    using Ifc_DccTimestamps = rte::ifc_sr_array<dcc_timestamps_array>;
+    using Ifc_OnboardTargetTimestamps = rte::ifc_sr_array<onboard_timestamps_array>;
+    /// Count, min, avg, max and histogram, see util::statistics::copy_to()
+    using Ifc_DccLatency = rte::ifc_sr_array<dcc_latency_array>;
+#endif
+
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+    // -----------------------------------------------------------------------------------
+    /// Signal quality of the DCC signal (see CFG_DCC_DECODER_HALFBIT_HISTOGRAM), updated
+    /// once per measurement window by DccDecoder.
+    // -----------------------------------------------------------------------------------
+    using dcc_halfbit_histogram_type = dcc::halfbit_histogram<>;
+    /// Number of time deltas per bin: < 40 us, 40 - 43 us, ..., 136 - 139 us, >= 140 us
+    using dcc_halfbit_histogram_array = util::array<uint16, dcc_halfbit_histogram_type::kNrBins>;
+    /// Mean short and long half bit [0.1 us], asymmetry [0.1 us], out of spec [0.1 %], packets per second
+    using dcc_signal_quality_array = util::array<uint16, dcc_halfbit_histogram_type::kNrMetrics>;
+
+    using Ifc_DccHalfBitHistogram = rte::ifc_sr_array<dcc_halfbit_histogram_array>;
+    using Ifc_DccSignalQuality = rte::ifc_sr_array<dcc_signal_quality_array>;
+#endif
+
     /// SR interface for DCC address (calculated from calibration data)
     using Ifc_Cal_DccAddress = rte::ifc_sr<uint16>;
 
@@ -61,6 +61,10 @@ namespace signal
                     changeOverTimer.start(scale_10ms_1ms(signal_asp.change_over_time_10ms));
                 }
                 aspect_tgt = signal_asp.aspect;
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+                // one latency sample per aspect change: the first output carries the time stamp
+                signal_rte::forward_timestamp(signal_cal::get_input_cmd(signal_idx), signal_cal::get_first_output(signal_idx));
+#endif
             }
         }
 
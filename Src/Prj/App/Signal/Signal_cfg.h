@@ -117,6 +117,26 @@ namespace signal_rte
     {
         rte::ifc_rte_set_intensity::call(target, intensity);
     }
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    /**
+     * Forwards the time stamp of the DCC packet that changed the command of the input
+     * to the target (for latency measurement in LedRouter). Does nothing if the input
+     * is not a DCC input or if there is no time stamp.
+     */
+    inline void forward_timestamp(struct signal::input_cmd input, const struct signal::target target)
+    {
+        uint32 timestamp = 0U;
+        if ((input.type == signal::input_cmd::kDcc) && rte::ifc_dcc_timestamps::boundaryCheck(input.idx))
+        {
+            rte::ifc_dcc_timestamps::readElement(input.idx, timestamp);
+        }
+        if ((timestamp != 0U) && (target.type == signal::target::kOnboard) && 
+            rte::ifc_onboard_target_timestamps::boundaryCheck(target.pin))
+        {
+            rte::ifc_onboard_target_timestamps::writeElement(target.pin, timestamp);
+        }
+    }
+#endif
 
 }
 
@@ -0,0 +1,231 @@
+/**
+ * @file Ut_CvProgramming/Test.cpp
+ *
+ * @brief Unit tests for dcc::cv_programming of Gen/Dcc/CvProgramming.h
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <initializer_list>
+#include <unity_adapt.h>
+#include <Hal/Timer.h>
+#include <Dcc/DecodedCommand.h>
+#include <Dcc/CvProgramming.h>
+#include <Dcc/BitmapFilter.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_type = dcc::packet<6>;
+using command_type = dcc::decoded_command<packet_type>;
+using programming_type = dcc::cv_programming<command_type, 50U>;
+using request_type = programming_type::request_type;
+
+// -----------------------------------------------------------------------
+/// Returns a decoded command of a packet with bytes and checksum
+// -----------------------------------------------------------------------
+static command_type make_command(std::initializer_list<uint8> bytes)
+{
+  packet_type pkt = make_packet(bytes);
+  command_type cmd;
+  cmd.assign(pkt, 0U);
+  return cmd;
+}
+
+// -----------------------------------------------------------------------
+/// @brief Operations mode: an instruction is executed on the second identical instruction, once
+// -----------------------------------------------------------------------
+TEST(Ut_CvProgramming, ops_mode_write)
+{
+  programming_type prog;
+  request_type req{};
+  hal::stubs::millis = 1000U;
+
+  // basic accessory decoder 1: write CV 33 = 0x2A
+  const command_type write = make_command({ 0x81, 0xF0, 0xEC, 0x20, 0x2A });
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.execute(write, req), true);
+  EXPECT_EQ(req.cv, uint16{ 33 });
+  EXPECT_EQ(req.operation, packet_type::kCvWriteByte);
+  EXPECT_EQ(req.is_write(), true);
+  EXPECT_EQ(req.service_mode, false);
+  EXPECT_EQ(req.apply(0U), uint8{ 0x2A });
+  // repetitions are not executed again
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.execute(write, req), false);
+
+  // a different instruction in between restarts
+  const command_type other = make_command({ 0x81, 0xF0, 0xEC, 0x20, 0x2B });
+  EXPECT_EQ(prog.execute(other, req), false);
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.execute(write, req), true);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Bit manipulation: write and verify single bits, verify byte
+// -----------------------------------------------------------------------
+TEST(Ut_CvProgramming, bit_manipulation)
+{
+  programming_type prog;
+  request_type req{};
+  hal::stubs::millis = 2000U;
+
+  // CV 29, write bit 5 = 1 (111KDBBB = 11111101)
+  const command_type write_bit = make_command({ 0x81, 0xF0, 0xE8, 0x1C, 0xFD });
+  EXPECT_EQ(prog.execute(write_bit, req), false);
+  EXPECT_EQ(prog.execute(write_bit, req), true);
+  EXPECT_EQ(req.cv, uint16{ 29 });
+  EXPECT_EQ(req.is_write(), true);
+  EXPECT_EQ(req.apply(0x01U), uint8{ 0x21 });
+  EXPECT_EQ(req.apply(0x21U), uint8{ 0x21 });
+
+  // CV 29, verify bit 0 = 0 (111KDBBB = 11100000)
+  const command_type verify_bit = make_command({ 0x81, 0xF0, 0xE8, 0x1C, 0xE0 });
+  EXPECT_EQ(prog.execute(verify_bit, req), false);
+  EXPECT_EQ(prog.execute(verify_bit, req), true);
+  EXPECT_EQ(req.is_write(), false);
+  EXPECT_EQ(req.verify(0x20U), true);
+  EXPECT_EQ(req.verify(0x21U), false);
+
+  // CV 1, verify byte 0x05
+  const command_type verify_byte = make_command({ 0x81, 0xF0, 0xE4, 0x00, 0x05 });
+  EXPECT_EQ(prog.execute(verify_byte, req), false);
+  EXPECT_EQ(prog.execute(verify_byte, req), true);
+  EXPECT_EQ(req.cv, uint16{ 1 });
+  EXPECT_EQ(req.is_write(), false);
+  EXPECT_EQ(req.verify(0x05U), true);
+  EXPECT_EQ(req.verify(0x06U), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Service mode is entered with a reset packet and ends with a timeout or another packet
+// -----------------------------------------------------------------------
+TEST(Ut_CvProgramming, service_mode)
+{
+  programming_type prog;
+  request_type req{};
+  hal::stubs::millis = 3000U;
+
+  const command_type reset = make_command({ 0x00, 0x00 });
+  // direct mode: write CV 1 = 0x03
+  const command_type write = make_command({ 0x7C, 0x00, 0x03 });
+  const command_type loco = make_command({ 0x03, 0x3F, 0x80 });
+
+  // ignored outside of service mode (multi function packet for address 124)
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.is_service_mode(), false);
+
+  EXPECT_EQ(prog.execute(reset, req), false);
+  EXPECT_EQ(prog.is_service_mode(), true);
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.execute(write, req), true);
+  EXPECT_EQ(req.cv, uint16{ 1 });
+  EXPECT_EQ(req.service_mode, true);
+  EXPECT_EQ(req.apply(0x01U), uint8{ 0x03 });
+
+  // timeout
+  hal::stubs::millis += 49U;
+  EXPECT_EQ(prog.execute(reset, req), false);
+  EXPECT_EQ(prog.is_service_mode(), true);
+  hal::stubs::millis += 50U;
+  EXPECT_EQ(prog.execute(write, req), false);
+  EXPECT_EQ(prog.is_service_mode(), false);
+
+  // any other packet ends service mode
+  EXPECT_EQ(prog.execute(reset, req), false);
+  EXPECT_EQ(prog.is_service_mode(), true);
+  EXPECT_EQ(prog.execute(loco, req), false);
+  EXPECT_EQ(prog.is_service_mode(), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Main track: multi function packets for address 124 after a reset packet pass neither
+/// the address filter nor write a CV, service mode instructions on a programming track do
+// -----------------------------------------------------------------------
+TEST(Ut_CvProgramming, service_mode_address_filter)
+{
+  using filter_type = dcc::accessory_bitmap_filter<packet_type>;
+  programming_type prog;
+  request_type req{};
+  filter_type filter;
+  filter.set(1U);
+  filter.enable_service_mode(true);
+  hal::stubs::millis = 5000U;
+
+  // Returns true if pkt passes the filter and its command is executed
+  auto receive = [&filter, &prog, &req](packet_type pkt) -> bool
+  {
+    if (!filter.do_filter(pkt))
+    {
+      return false;
+    }
+    command_type cmd;
+    cmd.assign(pkt, 0U);
+    return prog.execute(cmd, req);
+  };
+
+  const packet_type reset = make_packet({ 0x00, 0x00 });
+  const packet_type idle = make_packet({ 0xFF, 0x00 });
+  // address 124: speed and direction, or direct mode: write CV 64 = 0xAA
+  const packet_type loco = make_packet({ 0x7C, 0x3F, 0xAA });
+  const packet_type other_loco = make_packet({ 0x03, 0x3F, 0x80 });
+  // direct mode: write CV 1 = 0x03
+  const packet_type write = make_packet({ 0x7C, 0x00, 0x03 });
+
+  // main track: a single reset packet followed by the packets of the command station
+  EXPECT_EQ(receive(reset), false);
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_EQ(receive(loco), false);
+    EXPECT_EQ(receive(idle), false);
+    EXPECT_EQ(receive(loco), false);
+    EXPECT_EQ(receive(other_loco), false);
+  }
+  // main track: reset packets after power on followed by loco 124 only
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_EQ(receive(reset), false);
+  }
+  EXPECT_EQ(receive(idle), false);
+  EXPECT_EQ(receive(loco), false);
+  EXPECT_EQ(receive(loco), false);
+  EXPECT_EQ(filter.is_service_mode(), false);
+
+  // programming track: reset packets followed by identical service mode instructions
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_EQ(receive(reset), false);
+  }
+  EXPECT_EQ(receive(write), false);
+  EXPECT_EQ(receive(write), true);
+  EXPECT_EQ(req.cv, uint16{ 1 });
+  EXPECT_EQ(req.service_mode, true);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(ops_mode_write);
+  RUN_TEST(bit_manipulation);
+  RUN_TEST(service_mode);
+  RUN_TEST(service_mode_address_filter);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file Ut_Dcc_Helper.h
+ *
+ * @brief Test fixtures shared by the unit tests of Gen/Dcc
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef UT_DCC_HELPER_H
+#define UT_DCC_HELPER_H
+
+#include <initializer_list>
+#include <vector>
+#include <Std_Types.h>
+#include <Dcc/Packet.h>
+#include <Dcc/Encoder.h>
+#include <Dcc/PacketExtractor.h>
+
+// -----------------------------------------------------------------------
+/// Returns a packet with bytes and checksum (if checksum is true)
+// -----------------------------------------------------------------------
+template<class Packet = dcc::packet<> >
+static Packet make_packet(std::initializer_list<uint8> bytes, bool checksum = true)
+{
+  Packet pkt;
+  uint8 x = 0U;
+  for (uint8 b : bytes)
+  {
+    (void) pkt.add_byte(b);
+    x ^= b;
+  }
+  if (checksum)
+  {
+    (void) pkt.add_byte(x);
+  }
+  return pkt;
+}
+
+// -----------------------------------------------------------------------
+/// A bit extractor that records all time deltas
+// -----------------------------------------------------------------------
+class DeltaRecorderClass
+{
+public:
+  std::vector<uint32> deltas;
+  void execute(uint32 dt) { deltas.push_back(dt); }
+};
+
+// -----------------------------------------------------------------------
+/// A handler class that counts packets with a valid checksum
+// -----------------------------------------------------------------------
+class PacketCounterClass : public dcc::packet_extractor<>::handler_ifc
+{
+public:
+  using packet_type = dcc::packet_extractor<>::packet_type;
+  uint32 nr_checksum_ok;
+  PacketCounterClass() : nr_checksum_ok(0) {}
+  virtual void packet_received(packet_type& pkt) override
+  {
+    if (pkt.is_checksum_ok())
+    {
+      nr_checksum_ok++;
+    }
+  }
+};
+
+// -----------------------------------------------------------------------
+/// Returns time deltas of nr_refreshs refreshs of 256 accessory decoders (first output)
+// -----------------------------------------------------------------------
+template<class Encoder>
+static std::vector<uint16> make_waveform(Encoder& enc, int nr_refreshs)
+{
+  using packet_type = typename Encoder::packet_type;
+  std::vector<uint16> deltas;
+  for (int i = 0; i < nr_refreshs; i++)
+  {
+    for (int addr = 1; addr <= 256; addr++)
+    {
+      const uint8 byte0 = static_cast<uint8>(0x80U | (addr & 0x3F));
+      const uint8 byte1 = static_cast<uint8>(0x80U | ((~(addr >> 6) & 0x07U) << 4U) | 0x08U);
+      enc.encode(make_packet<packet_type>({ byte0, byte1 }), [&deltas](uint16 dt) { deltas.push_back(dt); });
+    }
+  }
+  return deltas;
+}
+
+#endif // UT_DCC_HELPER_H
@@ -0,0 +1,102 @@
+/**
+ * @file Ut_Dcc_Performance/Dcc/DecoderCfg.h
+ * 
+ * @author Ralf Sondershaus
+ * 
+ * @brief DCC Decoder configuration definitions for Ut_Dcc_Performance.
+ *
+ * @copyright Copyright (c) 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef DCC_DECODERCFG_H
+#define DCC_DECODERCFG_H
+#include <Std_Types.h>
+
+#define OPT_DCC_DECODER_DEBUG_ON       1
+#define OPT_DCC_DECODER_DEBUG_OFF      0
+
+/** Select option for DCC decoder debug */
+#define CFG_DCC_DECODER_DEBUG          OPT_DCC_DECODER_DEBUG_OFF
+
+/** Number of slots of the packet FIFO (power of two, max 256). The FIFO stores one packet less. */
+#define CFG_DCC_DECODER_FIFO_SIZE     8
+
+#define OPT_DCC_DECODER_FIFO_DROP_NEWEST  0  ///< A new packet is dropped if the FIFO is full
+#define OPT_DCC_DECODER_FIFO_DROP_OLDEST  1  ///< The oldest packet is dropped if the FIFO is full
+
+/** Select which packet is dropped if the packet FIFO is full */
+#define CFG_DCC_DECODER_FIFO_POLICY   OPT_DCC_DECODER_FIFO_DROP_NEWEST
+
+#define OPT_DCC_DECODER_MODE_ISR       0  ///< Edges are decoded within the ISR
+#define OPT_DCC_DECODER_MODE_DEFERRED  1  ///< ISR stores edges, decoder::process_edges() decodes them
+
+/** Select where edges are decoded */
+#define CFG_DCC_DECODER_MODE           OPT_DCC_DECODER_MODE_ISR
+
+/** Number of slots of the edge ring in deferred mode (power of two, max 256). Shall hold the 
+ *  edges that arrive between two calls of decoder::process_edges() (about 172 edges per 10 ms) */
+#define CFG_DCC_DECODER_EDGE_RING_SIZE 256
+
+#define OPT_DCC_DECODER_REJECT_BAD_CHECKSUM_OFF  0  ///< Packets with a bad checksum are forwarded (see packet::is_checksum_ok())
+#define OPT_DCC_DECODER_REJECT_BAD_CHECKSUM_ON   1  ///< Packets with a bad checksum are dropped by the packet extractor
+
+/** Select if the packet extractor drops packets with a bad checksum */
+#define CFG_DCC_DECODER_REJECT_BAD_CHECKSUM      OPT_DCC_DECODER_REJECT_BAD_CHECKSUM_OFF
+
+/** Number of entries of dcc::repeat_filter (recent packets) */
+#define CFG_DCC_DECODER_REPEAT_FILTER_SIZE       8
+/** [ms] Time window in which dcc::repeat_filter suppresses repeated packets (max 65535) */
+#define CFG_DCC_DECODER_REPEAT_FILTER_WINDOW_MS  500
+
+#define OPT_DCC_DECODER_ADDRESS_FILTER_NONE       0  ///< No address filter is compiled in (see decoder::set_filter())
+#define OPT_DCC_DECODER_ADDRESS_FILTER_ACCESSORY  1  ///< dcc::accessory_bitmap_filter is compiled in
+#define OPT_DCC_DECODER_ADDRESS_FILTER_LOCO       2  ///< dcc::loco_bitmap_filter is compiled in
+
+/** Select the address filter that the decoder calls without indirection (see decoder::get_address_filter()) */
+#define CFG_DCC_DECODER_ADDRESS_FILTER           OPT_DCC_DECODER_ADDRESS_FILTER_ACCESSORY
+
+#define OPT_DCC_DECODER_TIMESTAMP_OFF  0  ///< Packets do not carry a time stamp
+#define OPT_DCC_DECODER_TIMESTAMP_ON   1  ///< The packet extractor stores hal::micros() in a packet when its end bit is received (see packet::get_timestamp())
+
+/** Select if packets carry a time stamp, e.g. to measure the latency from DCC packet to output */
+#define CFG_DCC_DECODER_TIMESTAMP      OPT_DCC_DECODER_TIMESTAMP_OFF
+
+#define OPT_DCC_DECODER_GLITCH_FILTER_OFF  0  ///< Time deltas are passed to the bit extractor as they are
+#define OPT_DCC_DECODER_GLITCH_FILTER_ON   1  ///< dcc::glitch_filter merges short spikes into the neighbouring half bit
+
+/** Select if the decoder uses dcc::glitch_filter in front of the bit extractor */
+#define CFG_DCC_DECODER_GLITCH_FILTER            OPT_DCC_DECODER_GLITCH_FILTER_OFF
+/** [us] Time deltas below this value are glitches (shall be less than half of the shortest half bit) */
+#define CFG_DCC_DECODER_GLITCH_MAX_US            20
+/** Maximal number of glitches within one bit (two half bits); more glitches reset the bit extractor */
+#define CFG_DCC_DECODER_GLITCH_MAX_PER_BIT       2
+
+#define OPT_DCC_DECODER_HALFBIT_HISTOGRAM_OFF  0  ///< No histogram of time deltas
+#define OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON   1  ///< The ISR adds each time delta to dcc::halfbit_histogram (see decoder::get_halfbit_histogram())
+
+/** Select if the decoder collects a histogram of time deltas for signal quality metrics */
+#define CFG_DCC_DECODER_HALFBIT_HISTOGRAM      OPT_DCC_DECODER_HALFBIT_HISTOGRAM_OFF
+
+#define OPT_DCC_DECODER_DECODED_COMMAND_OFF  0  ///< The packet FIFO stores packets (see decoder::front())
+#define OPT_DCC_DECODER_DECODED_COMMAND_ON   1  ///< Packets are decoded once into dcc::decoded_command when they are complete; the FIFO stores commands
+
+/** Select if the decoder stores packets or decoded commands in the FIFO */
+#define CFG_DCC_DECODER_DECODED_COMMAND      OPT_DCC_DECODER_DECODED_COMMAND_OFF
+
+#define OPT_DCC_DECODER_CALIBRATION_OFF  0  ///< Time deltas are passed to the bit extractor unscaled
+#define OPT_DCC_DECODER_CALIBRATION_ON   1  ///< dcc::timing_calibration measures preambles and scales the time deltas to nominal
+
+/** Select if the decoder uses dcc::timing_calibration in front of the bit extractor */
+#define CFG_DCC_DECODER_CALIBRATION            OPT_DCC_DECODER_CALIBRATION_OFF
+/** [%] Maximal deviation of the clock (or of the half bits of the command station) from nominal */
+#define CFG_DCC_DECODER_CALIBRATION_MAX_SKEW   25
+
+#define OPT_DCC_DECODER_EARLY_REJECT_OFF  0  ///< The packet extractor assembles all packets
+#define OPT_DCC_DECODER_EARLY_REJECT_ON   1  ///< The packet extractor asks the address filter after the first byte and skips packets for other decoders (see decoder::accept_first_byte())
+
+/** Select if packets for other decoders are skipped after their first byte */
+#define CFG_DCC_DECODER_EARLY_REJECT      OPT_DCC_DECODER_EARLY_REJECT_OFF
+#endif // DCC_DECODERCFG_H
\ No newline at end of file
@@ -0,0 +1,417 @@
+/**
+ * @file Ut_Dcc_Performance/Test.cpp
+ *
+ * @brief Replays a trace of edge deltas through the DCC decode pipeline and measures run time on
+ * the host
+ *
+ * The trace is read from a binary file with little-endian uint16 time deltas [us] (e.g. a capture
+ * from a layout). The file name is taken from environment variable DCC_TRACE; the default is
+ * Ut_Dcc_Performance_Trace.bin in the working directory. If the file does not exist, a trace with
+ * typical layout traffic is generated with dcc::encoder.
+ *
+ * The full pipeline is driven through dcc::decoder::on_edge() with stubbed hal::micros(). The main
+ * loop is simulated every 10 ms of track time (the FIFO is emptied). The time split per stage is measured
+ * by running the stages separately:
+ * - bit_extractor: bit extraction only (bits are recorded)
+ * - packet_extractor: packet assembly from the recorded bits
+ * - packet_extractor_early_reject: packet assembly with early reject on the address filter (packets
+ *   for other decoders are skipped after the first byte)
+ * - filter: the decoder's address filter on the decoded packets
+ * - fifo: the decoder's packet FIFO (commit, fetch and pop) on the packets that pass the filter
+ *
+ * The results are printed and appended to Ut_Dcc_Performance.csv (git hash, metric, value, unit)
+ * so that runs of different commits can be compared.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <Hal/Serial.h>
+#include <Hal/Timer.h>
+#include <unity_adapt.h>
+#include <Dcc/Decoder.h>
+#include <Dcc/Encoder.h>
+#include <Ut_Dcc_Helper.h>
+#include "GitVersion.h"
+
+// GitVersion.h is generated by the build; the hash is 0 if git is not available
+#ifndef GIT_SHORT_HASH
+#define GIT_SHORT_HASH 0
+#endif
+
+using packet_type = dcc::decoder::packet_type;
+using encoder_type = dcc::encoder<packet_type>;
+
+/// [us] Main loop cycle time (track time)
+static constexpr uint32 kCycleTime_us = 10000U;
+/// First output address and number of output addresses of the address filter
+static constexpr uint16 kFirstAddress = 1U;
+static constexpr uint16 kNrAddresses = 64U;
+
+/**
+ * @brief Events of the bit extractor (one byte per event)
+ */
+enum : uint8
+{
+  kZero = 0U,
+  kOne = 1U,
+  kInvalid = 2U
+};
+
+/**
+ * @brief Records the events of the bit extractor. Used as packet extractor of the bit extractor.
+ */
+class BitRecorderClass
+{
+public:
+  std::vector<uint8> events;
+  void one() { events.push_back(kOne); }
+  void zero() { events.push_back(kZero); }
+  void invalid() { events.push_back(kInvalid); }
+};
+
+/**
+ * @brief Records the packets of the packet extractor (bound at compile time)
+ */
+class PacketRecorderClass
+{
+public:
+  std::vector<packet_type> packets;
+  void packet_received(packet_type& pkt) { packets.push_back(pkt); }
+  packet_type* get_packet_slot() { return nullptr; }
+};
+
+/**
+ * @brief Counts the packets of the packet extractor (bound at compile time)
+ */
+class PacketCounterStaticClass
+{
+public:
+  uint32 nr_packets;
+  PacketCounterStaticClass() : nr_packets(0) {}
+  void packet_received(packet_type&) { nr_packets++; }
+  packet_type* get_packet_slot() { return nullptr; }
+};
+
+/**
+ * @brief Counts the packets that are not rejected by the address filter after the first byte
+ */
+class PacketCounterEarlyRejectClass
+{
+public:
+  uint32 nr_packets;
+  const dcc::decoder::address_filter_type& filter;
+  PacketCounterEarlyRejectClass(const dcc::decoder::address_filter_type& f) : nr_packets(0), filter(f) {}
+  void packet_received(packet_type&) { nr_packets++; }
+  packet_type* get_packet_slot() { return nullptr; }
+  bool accept_first_byte(uint8 byte0) const { return filter.may_pass(byte0); }
+};
+
+using recorder_bit_extractor_type = dcc::bit_extractor<dcc::bit_extractor_constants<>, BitRecorderClass>;
+using recorder_packet_extractor_type = dcc::packet_extractor<10, PacketRecorderClass>;
+using counter_packet_extractor_type = dcc::packet_extractor<10, PacketCounterStaticClass>;
+using early_reject_packet_extractor_type = dcc::packet_extractor<10, PacketCounterEarlyRejectClass, true>;
+
+/**
+ * @brief Returns a trace with layout traffic: refresh of 256 accessory decoders (both outputs
+ * of the first pair) interleaved with idle, loco speed and loco function packets. With jitter
+ * and RailCom cutouts.
+ */
+static std::vector<uint16> generate_trace()
+{
+  encoder_type::config_type cfg = encoder_type::default_config();
+  cfg.jitter_us = 4U;
+  cfg.cutout_us = 464U;
+  encoder_type enc(cfg);
+  std::vector<uint16> deltas;
+  auto sink = [&deltas](uint16 dt) { deltas.push_back(dt); };
+
+  for (int refresh = 0; refresh < 8; refresh++)
+  {
+    for (int addr = 1; addr <= 256; addr++)
+    {
+      const uint8 byte0 = static_cast<uint8>(0x80U | (addr & 0x3F));
+      const uint8 byte1 = static_cast<uint8>(0x80U | ((~(addr >> 6) & 0x07U) << 4U) | 0x08U | (refresh & 0x01));
+      enc.encode(make_packet({ byte0, byte1 }), sink);
+      enc.encode(make_packet({ 0xFF, 0x00 }), sink);
+      enc.encode(make_packet({ static_cast<uint8>(addr & 0x7F), 0x3F, 0x90 }), sink);
+      enc.encode(make_packet({ static_cast<uint8>(addr & 0x7F), 0x80 }), sink);
+    }
+  }
+  return deltas;
+}
+
+/**
+ * @brief Returns the trace from the file (see file header) or a generated trace
+ */
+static const std::vector<uint16>& get_trace()
+{
+  static std::vector<uint16> deltas;
+  if (deltas.empty())
+  {
+    const char *name = std::getenv("DCC_TRACE");
+    FILE *f = std::fopen((name != nullptr) ? name : "Ut_Dcc_Performance_Trace.bin", "rb");
+    if (f != nullptr)
+    {
+      uint8 buf[2];
+      while (std::fread(buf, 1, 2, f) == 2U)
+      {
+        deltas.push_back(static_cast<uint16>(buf[0] | (buf[1] << 8U)));
+      }
+      std::fclose(f);
+      hal::serial::print("Trace from file: ");
+    }
+    else
+    {
+      deltas = generate_trace();
+      hal::serial::print("Generated trace: ");
+    }
+    hal::serial::print(static_cast<uint32>(deltas.size()));
+    hal::serial::println(" edges");
+  }
+  return deltas;
+}
+
+/**
+ * @brief Returns the wall clock time [us] since an arbitrary point (hal::micros() is stubbed)
+ */
+static uint64_t now_us()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Print a result and append it to Ut_Dcc_Performance.csv (with a header line if the file is new)
+ */
+static void report(const char *metric, uint64_t value, const char *unit)
+{
+  hal::serial::print(metric);
+  hal::serial::print(": ");
+  hal::serial::print(static_cast<uint32>(value));
+  hal::serial::print(" ");
+  hal::serial::println(unit);
+
+  FILE *f = std::fopen("Ut_Dcc_Performance.csv", "r");
+  const bool is_new = (f == nullptr);
+  if (f != nullptr)
+  {
+    std::fclose(f);
+  }
+  f = std::fopen("Ut_Dcc_Performance.csv", "a");
+  if (f != nullptr)
+  {
+    if (is_new)
+    {
+      std::fprintf(f, "git_hash,metric,value,unit\n");
+    }
+    std::fprintf(f, "%lx,%s,%llu,%s\n", static_cast<unsigned long>(GIT_SHORT_HASH), metric,
+                 static_cast<unsigned long long>(value), unit);
+    std::fclose(f);
+  }
+}
+
+/**
+ * @brief Returns n per second for n events in td_us
+ */
+static uint64_t per_second(uint64_t n, uint64_t td_us)
+{
+  return (td_us > 0U) ? (n * 1000000ULL) / td_us : 0ULL;
+}
+
+/// Result of the pipeline test, used to check the time split
+static uint32 nr_pipeline_packets;
+
+/**
+ * @brief Drive dcc::decoder::on_edge() with the trace and empty the FIFO every kCycleTime_us of track time.
+ */
+TEST(Ut_Dcc_Performance, pipeline)
+{
+  const std::vector<uint16>& deltas = get_trace();
+  dcc::decoder& dec = dcc::decoder::get_instance();
+  dcc::decoder::address_filter_type& filter = dec.get_address_filter();
+  uint32 next_cycle = kCycleTime_us;
+  uint32 nr_packets = 0U;
+  uint32 nr_overflows = 0U;
+
+  filter.clear();
+  filter.set_cv29(dcc::cfg::kBitMask_Cv29_OutputAddressMethod);
+  filter.set_range(kFirstAddress, kFirstAddress + kNrAddresses - 1U);
+  dec.clear_fifo_overflow();
+  const uint16 drops = dec.get_fifo_drop_count();
+  hal::stubs::micros = 0U;
+
+  const uint64_t t1 = now_us();
+  for (uint16 dt : deltas)
+  {
+    hal::stubs::micros += dt;
+    dec.on_edge();
+    if (hal::stubs::micros >= next_cycle)
+    {
+      next_cycle += kCycleTime_us;
+      if (dec.is_fifo_overflow())
+      {
+        nr_overflows++;
+        dec.clear_fifo_overflow();
+      }
+      dec.process_edges();
+      dec.fetch();
+      while (!dec.empty())
+      {
+        dec.pop();
+        nr_packets++;
+      }
+    }
+  }
+  const uint64_t td = now_us() - t1;
+  nr_pipeline_packets = nr_packets;
+
+  EXPECT_EQ(nr_packets > 0U, true);
+  report("pipeline_edges_per_s", per_second(deltas.size(), td), "edges/s");
+  report("pipeline_packets_per_s", per_second(nr_packets, td), "packets/s");
+  report("pipeline_track_time", hal::stubs::micros / 1000U, "ms");
+  report("pipeline_packets", nr_packets, "packets");
+  report("fifo_overflow_cycles", nr_overflows, "cycles");
+  report("fifo_drops", static_cast<uint16>(dec.get_fifo_drop_count() - drops), "packets");
+  report("fifo_high_watermark", dec.get_fifo_high_watermark(), "packets");
+}
+
+/**
+ * @brief Time split of the pipeline: bit_extractor, packet_extractor, filter, fifo
+ */
+TEST(Ut_Dcc_Performance, stages)
+{
+  const std::vector<uint16>& deltas = get_trace();
+
+  // bit_extractor: record the bits
+  BitRecorderClass bits;
+  bits.events.reserve(deltas.size());
+  recorder_bit_extractor_type be(bits);
+  uint64_t t1 = now_us();
+  be.execute_many(deltas.data(), deltas.size());
+  const uint64_t td_bit = now_us() - t1;
+
+  // packet_extractor: replay the bits
+  PacketCounterStaticClass counter;
+  counter_packet_extractor_type pe(counter);
+  t1 = now_us();
+  for (uint8 ev : bits.events)
+  {
+    switch (ev)
+    {
+    case kOne:  pe.one();     break;
+    case kZero: pe.zero();    break;
+    default:    pe.invalid(); break;
+    }
+  }
+  const uint64_t td_packet = now_us() - t1;
+
+  // packet_extractor with early reject: replay the bits
+  dcc::decoder::address_filter_type early_filter;
+  early_filter.set_cv29(dcc::cfg::kBitMask_Cv29_OutputAddressMethod);
+  early_filter.set_range(kFirstAddress, kFirstAddress + kNrAddresses - 1U);
+  PacketCounterEarlyRejectClass early_counter(early_filter);
+  early_reject_packet_extractor_type pe_early(early_counter);
+  t1 = now_us();
+  for (uint8 ev : bits.events)
+  {
+    switch (ev)
+    {
+    case kOne:  pe_early.one();     break;
+    case kZero: pe_early.zero();    break;
+    default:    pe_early.invalid(); break;
+    }
+  }
+  const uint64_t td_packet_early = now_us() - t1;
+
+  // filter: record the packets, then run the address filter on them
+  PacketRecorderClass recorder;
+  recorder_packet_extractor_type pe_rec(recorder);
+  for (uint8 ev : bits.events)
+  {
+    switch (ev)
+    {
+    case kOne:  pe_rec.one();     break;
+    case kZero: pe_rec.zero();    break;
+    default:    pe_rec.invalid(); break;
+    }
+  }
+  dcc::decoder::address_filter_type filter;
+  filter.set_cv29(dcc::cfg::kBitMask_Cv29_OutputAddressMethod);
+  filter.set_range(kFirstAddress, kFirstAddress + kNrAddresses - 1U);
+  uint32 nr_pass = 0U;
+  t1 = now_us();
+  for (packet_type& pkt : recorder.packets)
+  {
+    if (filter.do_filter(pkt))
+    {
+      nr_pass++;
+    }
+  }
+  const uint64_t td_filter = now_us() - t1;
+
+  // fifo: commit the packets that pass the filter and pop them as the main loop does
+  std::vector<packet_type> passed;
+  for (packet_type& pkt : recorder.packets)
+  {
+    if (filter.do_filter(pkt))
+    {
+      passed.push_back(pkt);
+    }
+  }
+  util::spsc_queue<packet_type, CFG_DCC_DECODER_FIFO_SIZE> fifo;
+  uint32 nr_popped = 0U;
+  t1 = now_us();
+  for (const packet_type& pkt : passed)
+  {
+    fifo.back_slot() = pkt;
+    (void) fifo.commit();
+    nr_popped += (fifo.front().getNrBytes() > 0U) ? 1U : 0U;
+    fifo.pop();
+  }
+  const uint64_t td_fifo = now_us() - t1;
+
+  EXPECT_EQ(counter.nr_packets, static_cast<uint32>(recorder.packets.size()));
+  EXPECT_EQ(nr_pass, nr_pipeline_packets);
+  EXPECT_EQ(early_counter.nr_packets >= nr_pass, true);
+  EXPECT_EQ(nr_popped, nr_pass);
+
+  report("decoded_packets", counter.nr_packets, "packets");
+  report("stage_bit_extractor", td_bit, "us");
+  report("stage_packet_extractor", td_packet, "us");
+  report("stage_packet_extractor_early_reject", td_packet_early, "us");
+  report("early_reject_packets", early_counter.nr_packets, "packets");
+  report("stage_filter", td_filter, "us");
+  report("stage_fifo", td_fifo, "us");
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(pipeline);
+  RUN_TEST(stages);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
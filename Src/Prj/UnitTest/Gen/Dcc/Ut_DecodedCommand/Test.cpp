@@ -0,0 +1,167 @@
+/**
+ * @file Ut_DecodedCommand/Test.cpp
+ *
+ * @brief Unit tests for dcc::decoded_command of Gen/Dcc/DecodedCommand.h
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <initializer_list>
+#include <unity_adapt.h>
+#include <Dcc/DecodedCommand.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_type = dcc::packet<6>;
+using command_type = dcc::decoded_command<packet_type>;
+using type_type = command_type::type_type;
+
+// -----------------------------------------------------------------------
+/// @brief Basic accessory packets with decoder and output address method
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, basic_accessory)
+{
+  command_type cmd;
+  // decoder address 1, output pair 2 (DD = 01), direction 1, D = 1: 10000001 1111 1 01 1
+  packet_type pkt = make_packet({ 0x81, 0xFB });
+
+  cmd.assign(pkt, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::BasicAccessory));
+  EXPECT_EQ(cmd.get_address(), static_cast<command_type::address_type>(1));
+  EXPECT_EQ(cmd.is_checksum_ok(), true);
+  EXPECT_EQ(cmd.ba_get_output_direction(), uint8{ 1 });
+  EXPECT_EQ(cmd.ba_get_output_pair(), uint8{ 1 });
+  EXPECT_EQ(cmd.ba_get_output_power(), uint8{ 1 });
+
+  // output address method: (1 << 2 | 1) - 3 = 2
+  packet_type pkt2 = make_packet({ 0x81, 0xFB });
+  cmd.assign(pkt2, dcc::cfg::kBitMask_Cv29_OutputAddressMethod);
+  EXPECT_EQ(cmd.get_address(), static_cast<command_type::address_type>(2));
+  EXPECT_EQ(cmd.get_address(), pkt2.get_address(dcc::cfg::kBitMask_Cv29_OutputAddressMethod));
+}
+
+// -----------------------------------------------------------------------
+/// @brief Extended accessory packets carry the aspect
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, extended_accessory)
+{
+  command_type cmd;
+  // address 1: 10000001 01110001, aspect 17
+  packet_type pkt = make_packet({ 0x81, 0x71, 0x11 });
+
+  cmd.assign(pkt, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::ExtendedAccessory));
+  EXPECT_EQ(cmd.get_address(), pkt.get_address(0U));
+  EXPECT_EQ(cmd.ea_get_aspect(), uint8{ 17 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Multi function packets carry the first instruction byte
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, multi_function)
+{
+  command_type cmd;
+  packet_type pkt7 = make_packet({ 0x03, 0x74 });
+  cmd.assign(pkt7, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::MultiFunction7));
+  EXPECT_EQ(cmd.get_address(), static_cast<command_type::address_type>(3));
+  EXPECT_EQ(cmd.value, uint8{ 0x74 });
+
+  packet_type pkt14 = make_packet({ 0xC4, 0xD2, 0x3F, 0x85 });
+  cmd.assign(pkt14, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::MultiFunction14));
+  EXPECT_EQ(cmd.get_address(), static_cast<command_type::address_type>(0x04D2));
+  EXPECT_EQ(cmd.value, uint8{ 0x3F });
+}
+
+// -----------------------------------------------------------------------
+/// @brief CV access instructions and reset packets are marked
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, cv_access)
+{
+  command_type cmd;
+  // POM basic accessory decoder 1: verify CV 513 (VV = 10, VVVVVVVV = 0) = 0x55
+  packet_type pom = make_packet({ 0x81, 0xF0, 0xE6, 0x00, 0x55 });
+  cmd.assign(pom, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::BasicAccessory));
+  EXPECT_EQ(cmd.get_address(), static_cast<command_type::address_type>(1));
+  EXPECT_EQ(cmd.is_cv_access(), true);
+  EXPECT_EQ(cmd.is_service_mode(), false);
+  EXPECT_EQ(cmd.cv_get_number(), uint16{ 513 });
+  EXPECT_EQ(cmd.cv_get_operation(), packet_type::kCvVerifyByte);
+  EXPECT_EQ(cmd.cv_get_data(), uint8{ 0x55 });
+
+  // service mode direct: bit manipulation CV 29, write bit 7 = 1
+  packet_type service = make_packet({ 0x78, 0x1C, 0xFF });
+  cmd.assign(service, 0U);
+  EXPECT_EQ(cmd.is_cv_access(), true);
+  EXPECT_EQ(cmd.is_service_mode(), true);
+  EXPECT_EQ(cmd.cv_get_number(), uint16{ 29 });
+  EXPECT_EQ(cmd.cv_get_operation(), packet_type::kCvBitManipulation);
+
+  // reset packet
+  packet_type reset = make_packet({ 0x00, 0x00 });
+  cmd.assign(reset, 0U);
+  EXPECT_EQ(cmd.is_reset(), true);
+  EXPECT_EQ(cmd.is_cv_access(), false);
+
+  // a basic accessory packet is no CV access
+  packet_type ba = make_packet({ 0x81, 0xFB });
+  cmd.assign(ba, 0U);
+  EXPECT_EQ(cmd.is_cv_access(), false);
+  EXPECT_EQ(cmd.is_reset(), false);
+  EXPECT_EQ(cmd.ba_get_output_direction(), uint8{ 1 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Packets with a bad checksum are invalid and have no address
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, bad_checksum)
+{
+  command_type cmd;
+  packet_type pkt = make_packet({ 0x81, 0xFB, 0x00 }, false);
+
+  cmd.assign(pkt, 0U);
+  EXPECT_EQ(static_cast<int>(cmd.get_type()), static_cast<int>(type_type::Invalid));
+  EXPECT_EQ(cmd.is_checksum_ok(), false);
+  EXPECT_EQ(cmd.get_address(), packet_type::kInvalidAddress);
+  EXPECT_EQ(cmd.value, uint8{ 0 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief A decoded command takes less memory than a packet
+// -----------------------------------------------------------------------
+TEST(Ut_DecodedCommand, size)
+{
+  EXPECT_EQ(sizeof(command_type) < sizeof(packet_type), true);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(basic_accessory);
+  RUN_TEST(extended_accessory);
+  RUN_TEST(multi_function);
+  RUN_TEST(cv_access);
+  RUN_TEST(bad_checksum);
+  RUN_TEST(size);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
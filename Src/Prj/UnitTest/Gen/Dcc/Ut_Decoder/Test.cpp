@@ -0,0 +1,367 @@
+/**
+  * @file Test.cpp
+  *
+  * @author Ralf Sondershaus
+  *
+  * Unit Test for Gen/Dcc/Decoder.h
+  *
+  * The ISR is driven with stubbed hal::micros(). The decoder is configured in deferred mode
+  * and drops the oldest packet if the packet FIFO is full. Packets with a bad checksum are 
+  * rejected. Packets carry a time stamp (see Ut_Decoder/Dcc/DecoderCfg.h).
+  *
+  * Two decoder instances on two input pins are driven via the stubbed interrupts
+  * (hal::stubs::trigger_interrupt()).
+  *
+  * @copyright Copyright 2025 Ralf Sondershaus
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  */
+
+#include <vector>
+#include <unity_adapt.h>
+#include <Dcc/Decoder.h>
+#include <Dcc/Encoder.h>
+#include <Hal/Timer.h>
+#include <Hal/Interrupt.h>
+
+using packet_type = dcc::decoder::packet_type;
+using encoder_type = dcc::encoder<packet_type>;
+
+// -----------------------------------------------------------------------
+/// Trigger an edge dt microseconds after the previous edge
+// -----------------------------------------------------------------------
+static void edge(uint32 dt)
+{
+  hal::stubs::micros += dt;
+  dcc::decoder::get_instance().on_edge();
+}
+
+static void send_one()  { edge(58);  edge(58); }
+static void send_zero() { edge(100); edge(100); }
+
+// -----------------------------------------------------------------------
+/// Send a complete packet with 14 preamble bits. Checksum is not added.
+/// If process is true, pending edges are decoded after each byte.
+// -----------------------------------------------------------------------
+static void send_packet(const uint8 *bytes, size_t n, bool process = false)
+{
+  for (int i = 0; i < 14; i++)
+  {
+    send_one();
+  }
+  for (size_t b = 0; b < n; b++)
+  {
+    send_zero();
+    for (int bit = 7; bit >= 0; bit--)
+    {
+      if ((bytes[b] >> bit) & 1U)
+      {
+        send_one();
+      }
+      else
+      {
+        send_zero();
+      }
+    }
+    if (process)
+    {
+      dcc::decoder::get_instance().process_edges();
+    }
+  }
+  send_one();
+}
+
+// -----------------------------------------------------------------------
+/// Decode pending edges and remove all packets from the decoder's FIFO.
+/// Returns the number of packets removed.
+// -----------------------------------------------------------------------
+static int drain()
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  int n = 0;
+  dec.process_edges();
+  for (int i = 0; i < 2; i++)
+  {
+    dec.fetch();
+    while (!dec.empty())
+    {
+      dec.pop();
+      n++;
+    }
+  }
+  return n;
+}
+
+// -----------------------------------------------------------------------
+/// @brief In deferred mode, the ISR only stores edges; process_edges() decodes them.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, deferred_packet)
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  const uint8 bytes[] = { 0x81, 0xF8, 0x79 };
+
+  (void) drain();
+  send_packet(bytes, sizeof(bytes));
+
+  // nothing decoded yet
+  dec.fetch();
+  EXPECT_EQ(dec.empty(), true);
+
+  dec.process_edges();
+  dec.fetch();
+  EXPECT_EQ(dec.empty(), false);
+  packet_type &pkt = dec.front();
+  EXPECT_EQ(pkt.getNrBytes(), static_cast<decltype(pkt.getNrBytes())>(3));
+  EXPECT_EQ(pkt.refByte(0), bytes[0]);
+  EXPECT_EQ(pkt.refByte(1), bytes[1]);
+  EXPECT_EQ(pkt.refByte(2), bytes[2]);
+  dec.pop();
+  EXPECT_EQ(dec.empty(), true);
+  EXPECT_EQ(dec.get_edge_overrun_count(), uint16{ 0 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Edges that do not fit into the edge ring are counted as overruns.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, deferred_overrun)
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  const uint8 bytes[] = { 0x81, 0xF8, 0x79 };
+  // two packets with 2 * (14 preamble bits + 3 * 9 bits + end bit) edges each
+  constexpr uint16 kNrEdges = 2U * 2U * (14U + 3U * 9U + 1U);
+  constexpr uint16 kRingCapacity = CFG_DCC_DECODER_EDGE_RING_SIZE - 1U;
+
+  (void) drain();
+  const uint16 overruns = dec.get_edge_overrun_count();
+  send_packet(bytes, sizeof(bytes));
+  send_packet(bytes, sizeof(bytes));
+  EXPECT_EQ(static_cast<uint16>(dec.get_edge_overrun_count() - overruns), static_cast<uint16>(kNrEdges - kRingCapacity));
+
+  // the first packet fits into the edge ring, the second packet is lost
+  EXPECT_EQ(drain(), 1);
+  // the decoder recovers with the next packet
+
+  send_packet(bytes, sizeof(bytes), true);
+  EXPECT_EQ(drain(), 1);
+  EXPECT_EQ(static_cast<uint16>(dec.get_edge_overrun_count() - overruns), static_cast<uint16>(kNrEdges - kRingCapacity));
+}
+
+// -----------------------------------------------------------------------
+/// @brief If the packet FIFO is full, the oldest packets are dropped and counted.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, fifo_drop_oldest)
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  constexpr uint8 kNrPackets = dcc::decoder::kMaxNrPackets + 2U;
+
+  (void) drain();
+  dec.clear_fifo_overflow();
+  const uint16 drops = dec.get_fifo_drop_count();
+  for (uint8 i = 0; i < kNrPackets; i++)
+  {
+    const uint8 bytes[] = { 0x81, i, static_cast<uint8>(0x81U ^ i) };
+    send_packet(bytes, sizeof(bytes), true);
+  }
+  dec.process_edges();
+
+  EXPECT_EQ(dec.is_fifo_overflow(), true);
+  EXPECT_EQ(static_cast<uint16>(dec.get_fifo_drop_count() - drops), uint16{ 2 });
+  EXPECT_EQ(dec.get_fifo_high_watermark(), static_cast<dcc::decoder::size_type>(dcc::decoder::kMaxNrPackets));
+  EXPECT_EQ(dec.size(), static_cast<dcc::decoder::size_type>(dcc::decoder::kMaxNrPackets));
+
+  // the newest packets are kept
+  for (uint8 i = 2; i < kNrPackets; i++)
+  {
+    EXPECT_EQ(dec.empty(), false);
+    EXPECT_EQ(dec.front().refByte(1), i);
+    dec.pop();
+  }
+  EXPECT_EQ(dec.empty(), true);
+  dec.clear_fifo_overflow();
+  EXPECT_EQ(dec.is_fifo_overflow(), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Packets with a bad checksum do not take FIFO space.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, reject_bad_checksum)
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  const uint8 bad[] = { 0x81, 0xF8, 0x78 };
+  const uint8 good[] = { 0x81, 0xF8, 0x79 };
+
+  (void) drain();
+  dec.clear_fifo_overflow();
+  send_packet(bad, sizeof(bad), true);
+  send_packet(good, sizeof(good), true);
+  send_packet(bad, sizeof(bad), true);
+  dec.process_edges();
+
+  EXPECT_EQ(dec.size(), static_cast<dcc::decoder::size_type>(1));
+  EXPECT_EQ(dec.front().refByte(2), good[2]);
+  EXPECT_EQ(dec.front().is_checksum_ok(), true);
+  dec.pop();
+  EXPECT_EQ(dec.empty(), true);
+  EXPECT_EQ(dec.is_fifo_overflow(), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief The time stamp of a packet is hal::micros() when its end bit is decoded.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, timestamp)
+{
+  dcc::decoder &dec = dcc::decoder::get_instance();
+  const uint8 bytes[] = { 0x81, 0xF8, 0x79 };
+
+  (void) drain();
+  send_packet(bytes, sizeof(bytes));
+  // deferred mode: the end bit is decoded later
+  hal::stubs::micros += 1234U;
+  const uint32 t_decode = hal::stubs::micros;
+  dec.process_edges();
+  dec.fetch();
+  EXPECT_EQ(dec.empty(), false);
+  EXPECT_EQ(dec.front().get_timestamp(), t_decode);
+  dec.pop();
+  EXPECT_EQ(dec.empty(), true);
+}
+
+// -----------------------------------------------------------------------
+/// Returns the time deltas of packets { byte0, i, byte0 ^ i } for i in [0, n)
+// -----------------------------------------------------------------------
+static std::vector<uint16> make_waveform(const encoder_type::config_type& cfg, uint32 seed, uint8 byte0, uint8 n)
+{
+  encoder_type enc(cfg, seed);
+  std::vector<uint16> deltas;
+  for (uint8 i = 0; i < n; i++)
+  {
+    packet_type pkt;
+    (void) pkt.add_byte(byte0);
+    (void) pkt.add_byte(i);
+    (void) pkt.add_byte(static_cast<uint8>(byte0 ^ i));
+    enc.encode(pkt, [&deltas](uint16 dt) { deltas.push_back(dt); });
+  }
+  // the end bit of the last packet is decoded with the next half bit
+  deltas.push_back(cfg.one_us);
+  deltas.push_back(cfg.one_us);
+  return deltas;
+}
+
+// -----------------------------------------------------------------------
+/// Decode pending edges and append byte 1 of all packets in the decoder's FIFO to v.
+/// Appends 0xFF for packets with another byte 0 than byte0.
+// -----------------------------------------------------------------------
+static void collect(dcc::decoder &dec, uint8 byte0, std::vector<uint8> &v)
+{
+  dec.process_edges();
+  dec.fetch();
+  while (!dec.empty())
+  {
+    v.push_back((dec.front().refByte(0) == byte0) ? dec.front().refByte(1) : uint8{ 0xFF });
+    dec.pop();
+  }
+}
+
+// -----------------------------------------------------------------------
+/// @brief Two decoders on two input pins decode two interleaved waveforms independently.
+// -----------------------------------------------------------------------
+TEST(Ut_Decoder, two_instances)
+{
+  constexpr uint8 kNrPackets = 40U;
+  constexpr uint8 kPinA = 2U; // INT0
+  constexpr uint8 kPinB = 3U; // INT1
+  dcc::decoder dec_a;
+  dcc::decoder dec_b;
+  EXPECT_EQ(dec_a.init(kPinA), true);
+  EXPECT_EQ(dec_b.init(kPinB), true);
+
+  // different jitter and cutout so that the edges of both waveforms interleave irregularly
+  encoder_type::config_type cfg_a = encoder_type::default_config();
+  cfg_a.jitter_us = 3U;
+  encoder_type::config_type cfg_b = encoder_type::default_config();
+  cfg_b.jitter_us = 5U;
+  cfg_b.cutout_us = 464U;
+  const std::vector<uint16> deltas_a = make_waveform(cfg_a, 1U, 0x81U, kNrPackets);
+  const std::vector<uint16> deltas_b = make_waveform(cfg_b, 2U, 0x03U, kNrPackets);
+
+  // first edge of both waveforms; the edges are triggered in the order of their time
+  const uint32 t0 = hal::stubs::micros;
+  uint32 t_a = t0 + 7U;
+  uint32 t_b = t0 + 30U;
+  // number of triggered edges; a waveform with n time deltas has n + 1 edges
+  size_t e_a = 0U;
+  size_t e_b = 0U;
+  uint32 nr_edges = 0U;
+  std::vector<uint8> rx_a;
+  std::vector<uint8> rx_b;
+  while ((e_a <= deltas_a.size()) || (e_b <= deltas_b.size()))
+  {
+    const bool next_a = (e_a <= deltas_a.size()) && ((e_b > deltas_b.size()) || (t_a <= t_b));
+    if (next_a)
+    {
+      hal::stubs::micros = t_a;
+      hal::stubs::trigger_interrupt(static_cast<uint8>(digitalPinToInterrupt(kPinA)));
+      t_a += (e_a < deltas_a.size()) ? deltas_a[e_a] : 0U;
+      e_a++;
+    }
+    else
+    {
+      hal::stubs::micros = t_b;
+      hal::stubs::trigger_interrupt(static_cast<uint8>(digitalPinToInterrupt(kPinB)));
+      t_b += (e_b < deltas_b.size()) ? deltas_b[e_b] : 0U;
+      e_b++;
+    }
+    // main loop
+    if (++nr_edges % 32U == 0U)
+    {
+      collect(dec_a, 0x81U, rx_a);
+      collect(dec_b, 0x03U, rx_b);
+    }
+  }
+  collect(dec_a, 0x81U, rx_a);
+  collect(dec_b, 0x03U, rx_b);
+
+  std::vector<uint8> expected;
+  for (uint8 i = 0; i < kNrPackets; i++)
+  {
+    expected.push_back(i);
+  }
+  EXPECT_EQ(rx_a == expected, true);
+  EXPECT_EQ(rx_b == expected, true);
+  EXPECT_EQ(dec_a.get_edge_overrun_count(), uint16{ 0 });
+  EXPECT_EQ(dec_b.get_edge_overrun_count(), uint16{ 0 });
+  EXPECT_EQ(dec_a.is_fifo_overflow(), false);
+  EXPECT_EQ(dec_b.is_fifo_overflow(), false);
+
+  hal::detachInterrupt(static_cast<uint8>(digitalPinToInterrupt(kPinA)));
+  hal::detachInterrupt(static_cast<uint8>(digitalPinToInterrupt(kPinB)));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(deferred_packet);
+  RUN_TEST(deferred_overrun);
+  RUN_TEST(fifo_drop_oldest);
+  RUN_TEST(reject_bad_checksum);
+  RUN_TEST(timestamp);
+  RUN_TEST(two_instances);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file Ut_Encoder/Test.cpp
+ *
+ * @brief Unit tests for dcc::encoder of Gen/Dcc/Encoder.h
+ *
+ * Packets are encoded into time deltas and decoded again with dcc::bit_extractor and
+ * dcc::packet_extractor.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+#include <Hal/Serial.h>
+#include <Hal/Timer.h>
+#include <unity_adapt.h>
+#include <Dcc/Encoder.h>
+#include <Dcc/BitExtractor.h>
+#include <Dcc/PacketExtractor.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_extractor_type = dcc::packet_extractor<>;
+using bit_extractor_type = dcc::bit_extractor<>;
+using packet_type = packet_extractor_type::packet_type;
+using encoder_type = dcc::encoder<packet_type>;
+
+// -----------------------------------------------------------------------
+/// A handler class that records all received packets.
+// -----------------------------------------------------------------------
+class PacketRecorderClass : public packet_extractor_type::handler_ifc
+{
+public:
+  std::vector<packet_type> packets;
+  uint32 nr_checksum_ok;
+  PacketRecorderClass() : nr_checksum_ok(0) {}
+  virtual void packet_received(packet_type& pkt) override
+  {
+    packets.push_back(pkt);
+    if (pkt.is_checksum_ok())
+    {
+      nr_checksum_ok++;
+    }
+  }
+};
+
+// -----------------------------------------------------------------------
+/// Returns true if the packets have the same bytes
+// -----------------------------------------------------------------------
+static bool is_equal(const packet_type& a, const packet_type& b)
+{
+  bool ret = (a.getNrBytes() == b.getNrBytes());
+  for (size_t i = 0; ret && (i < a.getNrBytes()); i++)
+  {
+    ret = (a.refByte(i) == b.refByte(i));
+  }
+  return ret;
+}
+
+// -----------------------------------------------------------------------
+/// Returns basic accessory packets for addresses 1 ... nr_addresses (both outputs),
+/// as a command station refreshes them
+// -----------------------------------------------------------------------
+static std::vector<packet_type> make_accessory_refresh(int nr_addresses)
+{
+  std::vector<packet_type> packets;
+  for (int addr = 1; addr <= nr_addresses; addr++)
+  {
+    const uint8 byte0 = static_cast<uint8>(0x80U | (addr & 0x3F));
+    const uint8 byte1 = static_cast<uint8>(0x80U | ((~(addr >> 6) & 0x07U) << 4U) | 0x08U);
+    packets.push_back(make_packet({ byte0, byte1 }));
+    packets.push_back(make_packet({ byte0, static_cast<uint8>(byte1 | 0x01U) }));
+  }
+  return packets;
+}
+
+// -----------------------------------------------------------------------
+/// @brief The time deltas of a packet: preamble, start bits, bytes, end bit
+// -----------------------------------------------------------------------
+TEST(Ut_Encoder, deltas)
+{
+  encoder_type enc;
+  const packet_type pkt = make_packet({ 0x81 });
+  uint16 deltas[encoder_type::max_nr_deltas(2, 14)];
+
+  // 14 preamble bits, 2 * (start bit + 8 bits), end bit
+  const size_t n = enc.encode(pkt, deltas, sizeof(deltas) / sizeof(deltas[0]));
+  EXPECT_EQ(n, static_cast<size_t>(2 * (14 + 2 * 9 + 1)));
+  for (size_t i = 0; i < 28; i++)
+  {
+    EXPECT_EQ(deltas[i], uint16{ 58 });
+  }
+  // start bit, then 0x81 = 1000 0001
+  EXPECT_EQ(deltas[28], uint16{ 100 });
+  EXPECT_EQ(deltas[29], uint16{ 100 });
+  EXPECT_EQ(deltas[30], uint16{ 58 });
+  EXPECT_EQ(deltas[32], uint16{ 100 });
+  EXPECT_EQ(deltas[44], uint16{ 58 });
+  // end bit
+  EXPECT_EQ(deltas[n - 1], uint16{ 58 });
+
+  // a small buffer is not overrun
+  EXPECT_EQ(enc.encode(pkt, deltas, 10), static_cast<size_t>(10));
+}
+
+// -----------------------------------------------------------------------
+/// @brief Encoded packets are decoded by bit_extractor::execute() (sink) and
+/// bit_extractor::execute_many() (buffer)
+// -----------------------------------------------------------------------
+TEST(Ut_Encoder, round_trip)
+{
+  const packet_type packets[] =
+  {
+    make_packet({ 0xFF, 0x00 }),
+    make_packet({ 0x03, 0x3F, 0x10 }),
+    make_packet({ 0x81, 0xF8 }),
+    make_packet({ 0xC1, 0x02, 0x3F, 0x80, 0x01 })
+  };
+  encoder_type enc;
+
+  PacketRecorderClass handler1;
+  packet_extractor_type pe1(handler1);
+  bit_extractor_type be1(pe1);
+  PacketRecorderClass handler2;
+  packet_extractor_type pe2(handler2);
+  bit_extractor_type be2(pe2);
+  std::vector<uint16> deltas(encoder_type::max_nr_deltas(packet_type::kMaxNrBytes, 14));
+
+  for (const packet_type& pkt : packets)
+  {
+    enc.encode(pkt, [&be1](uint16 dt) { be1.execute(dt); });
+    const size_t n = enc.encode(pkt, deltas.data(), deltas.size());
+    be2.execute_many(deltas.data(), n);
+  }
+
+  EXPECT_EQ(handler1.packets.size(), sizeof(packets) / sizeof(packets[0]));
+  EXPECT_EQ(handler2.packets.size(), sizeof(packets) / sizeof(packets[0]));
+  for (size_t i = 0; (i < handler1.packets.size()) && (i < handler2.packets.size()); i++)
+  {
+    EXPECT_EQ(is_equal(handler1.packets[i], packets[i]), true);
+    EXPECT_EQ(is_equal(handler2.packets[i], packets[i]), true);
+    EXPECT_EQ(handler1.packets[i].is_checksum_ok(), true);
+  }
+}
+
+// -----------------------------------------------------------------------
+/// @brief A preamble that is too short is not detected
+// -----------------------------------------------------------------------
+TEST(Ut_Encoder, preamble)
+{
+  const packet_type pkt = make_packet({ 0x81, 0xF8 });
+  encoder_type::config_type cfg = encoder_type::default_config();
+  encoder_type enc(cfg);
+  PacketRecorderClass handler;
+  packet_extractor_type pe(handler);
+  bit_extractor_type be(pe);
+  auto sink = [&be](uint16 dt) { be.execute(dt); };
+
+  enc.encode(pkt, sink);
+  EXPECT_EQ(handler.packets.size(), static_cast<size_t>(1));
+
+  cfg.preamble_nr_ones = 8U;
+  enc.set_config(cfg);
+  enc.encode(pkt, sink);
+  EXPECT_EQ(handler.packets.size(), static_cast<size_t>(1));
+
+  cfg.preamble_nr_ones = 10U;
+  enc.set_config(cfg);
+  enc.encode(pkt, sink);
+  EXPECT_EQ(handler.packets.size(), static_cast<size_t>(2));
+}
+
+// -----------------------------------------------------------------------
+/// @brief Layout scale traffic: 256 accessory addresses are refreshed several times with
+/// jitter and cutouts (no loss), and with bit errors (loss).
+// -----------------------------------------------------------------------
+TEST(Ut_Encoder, layout)
+{
+  constexpr int kNrRefreshs = 4;
+  const std::vector<packet_type> refresh = make_accessory_refresh(256);
+  encoder_type::config_type cfg = encoder_type::default_config();
+  cfg.jitter_us = 4U;
+  cfg.cutout_us = 464U;
+
+  {
+    encoder_type enc(cfg);
+    PacketRecorderClass handler;
+    packet_extractor_type pe(handler);
+    bit_extractor_type be(pe);
+    std::vector<uint16> deltas;
+    for (int i = 0; i < kNrRefreshs; i++)
+    {
+      for (const packet_type& pkt : refresh)
+      {
+        enc.encode(pkt, [&deltas](uint16 dt) { deltas.push_back(dt); });
+      }
+    }
+
+    const uint32 t1 = hal::micros();
+    be.execute_many(deltas.data(), deltas.size());
+    const uint32 td = hal::micros() - t1;
+
+    EXPECT_EQ(handler.packets.size(), kNrRefreshs * refresh.size());
+    EXPECT_EQ(handler.nr_checksum_ok, static_cast<uint32>(kNrRefreshs * refresh.size()));
+    hal::serial::print("layout: ");
+    hal::serial::print(static_cast<uint32>(handler.packets.size()));
+    hal::serial::print(" packets in ");
+    hal::serial::print(td);
+    hal::serial::println(" us");
+  }
+
+  {
+    // about one bit error per 650 bits, i.e. about every 15th packet
+    cfg.bit_error_rate = 100U;
+    encoder_type enc(cfg);
+    PacketRecorderClass handler;
+    packet_extractor_type pe(handler);
+    bit_extractor_type be(pe);
+    for (int i = 0; i < kNrRefreshs; i++)
+    {
+      for (const packet_type& pkt : refresh)
+      {
+        enc.encode(pkt, [&be](uint16 dt) { be.execute(dt); });
+      }
+    }
+
+    const uint32 nr_sent = static_cast<uint32>(kNrRefreshs * refresh.size());
+    const uint32 nr_lost = nr_sent - handler.nr_checksum_ok;
+    EXPECT_EQ(enc.get_bit_error_count() > 0U, true);
+    EXPECT_EQ(nr_lost > 0U, true);
+    // a bit error loses at most the packet and the next packet
+    EXPECT_EQ(nr_lost <= 2U * enc.get_bit_error_count(), true);
+    hal::serial::print("layout with bit errors: ");
+    hal::serial::print(enc.get_bit_error_count());
+    hal::serial::print(" bit errors, ");
+    hal::serial::print(nr_lost);
+    hal::serial::print(" of ");
+    hal::serial::print(nr_sent);
+    hal::serial::println(" packets lost");
+  }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(deltas);
+  RUN_TEST(round_trip);
+  RUN_TEST(preamble);
+  RUN_TEST(layout);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -3,7 +3,7 @@
  *
  * @author Ralf Sondershaus
  *
- * @brief Unit test for Gen/Dcc/Filter.h
+ * @brief Unit test for Gen/Dcc/Filter.h, Gen/Dcc/RepeatFilter.h and Gen/Dcc/BitmapFilter.h
  *
  * @copyright Copyright 2023 Ralf Sondershaus
  *
@@ -11,7 +11,10 @@
  */
 
 #include <Dcc/Filter.h>
+#include <Dcc/RepeatFilter.h>
+#include <Dcc/BitmapFilter.h>
 #include <Dcc/DecoderCfg.h>
+#include <Hal/Timer.h>
 #include <unity_adapt.h>
 
 /// 00000000              0         Broadcast address
@@ -97,6 +100,420 @@ TEST(Ut_Filter, filter_PassAddressFilter_1)
     EXPECT_EQ(filter.do_filter(packet), true);
 }
 
+// -----------------------------------------------------------------------
+/// @brief Test if the repeat filter suppresses repetitions within the time
+/// window and passes them again after the window.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_RepeatFilter_1)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::repeat_filter<packet_type, 4>;
+
+    filter_type filter(100U);
+    const uint8 bytes[] = { 0x81, 0xF8, 0x79 };
+    packet_type packet(bytes, sizeof(bytes) / sizeof(bytes[0]));
+
+    hal::stubs::millis = 1000U;
+    // The first packet passes, repetitions within the window do not.
+    EXPECT_EQ(filter.do_filter(packet), true);
+    hal::stubs::millis = 1050U;
+    EXPECT_EQ(filter.do_filter(packet), false);
+    hal::stubs::millis = 1099U;
+    EXPECT_EQ(filter.do_filter(packet), false);
+    // Repetitions do not restart the window.
+    hal::stubs::millis = 1100U;
+    EXPECT_EQ(filter.do_filter(packet), true);
+    hal::stubs::millis = 1150U;
+    EXPECT_EQ(filter.do_filter(packet), false);
+
+    EXPECT_EQ(filter.get_miss_count(), static_cast<uint32>(2));
+    EXPECT_EQ(filter.get_hit_count(), static_cast<uint32>(3));
+
+    // After clear(), the packet passes again.
+    filter.clear();
+    EXPECT_EQ(filter.do_filter(packet), true);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if a new command for the same primary address replaces the
+/// entry so that the previous command passes again, and if packets for
+/// different addresses replace the oldest entry.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_RepeatFilter_2)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::repeat_filter<packet_type, 2>;
+
+    filter_type filter(500U);
+    const uint8 bytes_on[] = { 0x81, 0xF9, 0x78 };
+    const uint8 bytes_off[] = { 0x81, 0xF8, 0x79 };
+    const uint8 bytes_a[] = { 0x82, 0xF8, 0x7A };
+    const uint8 bytes_b[] = { 0x83, 0xF8, 0x7B };
+    packet_type on(bytes_on, sizeof(bytes_on) / sizeof(bytes_on[0]));
+    packet_type off(bytes_off, sizeof(bytes_off) / sizeof(bytes_off[0]));
+    packet_type a(bytes_a, sizeof(bytes_a) / sizeof(bytes_a[0]));
+    packet_type b(bytes_b, sizeof(bytes_b) / sizeof(bytes_b[0]));
+
+    hal::stubs::millis = 2000U;
+    EXPECT_EQ(filter.do_filter(on), true);
+    EXPECT_EQ(filter.do_filter(off), true);
+    // on -> off -> on within the window: on passes again
+    EXPECT_EQ(filter.do_filter(on), true);
+    EXPECT_EQ(filter.do_filter(on), false);
+
+    // The same output uses one entry only, so a takes the free entry ...
+    hal::stubs::millis = 2010U;
+    EXPECT_EQ(filter.do_filter(a), true);
+    EXPECT_EQ(filter.do_filter(a), false);
+    // ... and b replaces the oldest entry (on)
+    hal::stubs::millis = 2020U;
+    EXPECT_EQ(filter.do_filter(b), true);
+    EXPECT_EQ(filter.do_filter(a), false);
+    EXPECT_EQ(filter.do_filter(on), true);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if the outputs of the same accessory decoder use separate
+/// entries so that interleaved repetitions to two outputs are suppressed.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_RepeatFilter_3)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::repeat_filter<packet_type, 4>;
+
+    filter_type filter(500U);
+    // basic accessory decoder 1: output pair 0 and 1, extended accessory decoder 1 and 2
+    const uint8 bytes_out0[] = { 0x81, 0xF8, 0x79 };
+    const uint8 bytes_out1[] = { 0x81, 0xFA, 0x7B };
+    const uint8 bytes_out1_other[] = { 0x81, 0xFB, 0x7A };
+    const uint8 bytes_ext1[] = { 0x81, 0x71, 0x05, 0xF5 };
+    const uint8 bytes_ext2[] = { 0x81, 0x73, 0x05, 0xF7 };
+    packet_type out0(bytes_out0, sizeof(bytes_out0) / sizeof(bytes_out0[0]));
+    packet_type out1(bytes_out1, sizeof(bytes_out1) / sizeof(bytes_out1[0]));
+    packet_type out1_other(bytes_out1_other, sizeof(bytes_out1_other) / sizeof(bytes_out1_other[0]));
+    packet_type ext1(bytes_ext1, sizeof(bytes_ext1) / sizeof(bytes_ext1[0]));
+    packet_type ext2(bytes_ext2, sizeof(bytes_ext2) / sizeof(bytes_ext2[0]));
+
+    EXPECT_EQ(filter_type::calc_key(out0) != filter_type::calc_key(out1), true);
+    EXPECT_EQ(filter_type::calc_key(out1), filter_type::calc_key(out1_other));
+    EXPECT_EQ(filter_type::calc_key(ext1) != filter_type::calc_key(ext2), true);
+    EXPECT_EQ(filter_type::calc_key(ext1) != filter_type::calc_key(out0), true);
+
+    hal::stubs::millis = 3000U;
+    EXPECT_EQ(filter.do_filter(out0), true);
+    EXPECT_EQ(filter.do_filter(out1), true);
+    EXPECT_EQ(filter.do_filter(ext1), true);
+    EXPECT_EQ(filter.do_filter(ext2), true);
+    // interleaved repetitions
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(filter.do_filter(out0), false);
+        EXPECT_EQ(filter.do_filter(out1), false);
+        EXPECT_EQ(filter.do_filter(ext1), false);
+        EXPECT_EQ(filter.do_filter(ext2), false);
+    }
+    // a new command for output pair 1 replaces its entry only
+    EXPECT_EQ(filter.do_filter(out1_other), true);
+    EXPECT_EQ(filter.do_filter(out0), false);
+    EXPECT_EQ(filter.do_filter(out1), true);
+    EXPECT_EQ(filter.get_miss_count(), static_cast<uint32>(6));
+
+    // clear() takes effect with the next packet
+    filter.clear();
+    EXPECT_EQ(filter.do_filter(out0), true);
+    EXPECT_EQ(filter.do_filter(out0), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if the speed and function packets of a loco use separate
+/// entries so that interleaved repetitions are suppressed, for 7 bit and
+/// 14 bit addresses.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_RepeatFilter_4)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::repeat_filter<packet_type, 8>;
+
+    filter_type filter(500U);
+    // loco 3: speed step forward, F0-F4, F5-F8; loco 1000 (0xC3 0xE8): speed, 128 speed steps
+    const uint8 bytes_speed[] = { 0x03, 0x68, 0x6B };
+    const uint8 bytes_speed_other[] = { 0x03, 0x48, 0x4B };
+    const uint8 bytes_f0[] = { 0x03, 0x90, 0x93 };
+    const uint8 bytes_f5[] = { 0x03, 0xB1, 0xB2 };
+    const uint8 bytes_long_speed[] = { 0xC3, 0xE8, 0x68, 0x43 };
+    const uint8 bytes_long_128[] = { 0xC3, 0xE8, 0x3F, 0x85, 0x91 };
+    // loco 1001 (0xC3 0xE9): same high byte
+    const uint8 bytes_long2_speed[] = { 0xC3, 0xE9, 0x68, 0x42 };
+    packet_type speed(bytes_speed, sizeof(bytes_speed) / sizeof(bytes_speed[0]));
+    packet_type speed_other(bytes_speed_other, sizeof(bytes_speed_other) / sizeof(bytes_speed_other[0]));
+    packet_type f0(bytes_f0, sizeof(bytes_f0) / sizeof(bytes_f0[0]));
+    packet_type f5(bytes_f5, sizeof(bytes_f5) / sizeof(bytes_f5[0]));
+    packet_type long_speed(bytes_long_speed, sizeof(bytes_long_speed) / sizeof(bytes_long_speed[0]));
+    packet_type long_128(bytes_long_128, sizeof(bytes_long_128) / sizeof(bytes_long_128[0]));
+    packet_type long2_speed(bytes_long2_speed, sizeof(bytes_long2_speed) / sizeof(bytes_long2_speed[0]));
+
+    EXPECT_EQ(filter_type::calc_key(speed), filter_type::calc_key(speed_other));
+    EXPECT_EQ(filter_type::calc_key(speed) != filter_type::calc_key(f0), true);
+    EXPECT_EQ(filter_type::calc_key(f0) != filter_type::calc_key(f5), true);
+    EXPECT_EQ(filter_type::calc_key(long_speed) != filter_type::calc_key(long2_speed), true);
+    EXPECT_EQ(filter_type::calc_key(long_speed) != filter_type::calc_key(long_128), true);
+
+    hal::stubs::millis = 4000U;
+    EXPECT_EQ(filter.do_filter(speed), true);
+    EXPECT_EQ(filter.do_filter(f0), true);
+    EXPECT_EQ(filter.do_filter(f5), true);
+    EXPECT_EQ(filter.do_filter(long_speed), true);
+    EXPECT_EQ(filter.do_filter(long_128), true);
+    EXPECT_EQ(filter.do_filter(long2_speed), true);
+    // interleaved repetitions of a refresh cycle
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(filter.do_filter(speed), false);
+        EXPECT_EQ(filter.do_filter(f0), false);
+        EXPECT_EQ(filter.do_filter(f5), false);
+        EXPECT_EQ(filter.do_filter(long_speed), false);
+        EXPECT_EQ(filter.do_filter(long_128), false);
+        EXPECT_EQ(filter.do_filter(long2_speed), false);
+    }
+    // a new speed replaces the speed entry only
+    EXPECT_EQ(filter.do_filter(speed_other), true);
+    EXPECT_EQ(filter.do_filter(f0), false);
+    EXPECT_EQ(filter.do_filter(speed), true);
+    EXPECT_EQ(filter.get_miss_count(), static_cast<uint32>(8));
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if the accessory bitmap filter lets the same basic and
+/// extended accessory packets pass as the accessory address filter, for
+/// both address methods.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_AccessoryBitmapFilter_1)
+{
+    using packet_type = dcc::packet<6>;
+    using bitmap_filter_type = dcc::accessory_bitmap_filter<packet_type>;
+    using range_filter_type = dcc::pass_accessory_address_filter<packet_type>;
+
+    const uint8 cv29_values[] = { 0U, dcc::cfg::kBitMask_Cv29_OutputAddressMethod };
+    for (uint8 cv29 : cv29_values)
+    {
+        bitmap_filter_type bitmap_filter;
+        range_filter_type range_filter(1U, 12U);
+        int nr_passed = 0;
+
+        bitmap_filter.set_cv29(cv29);
+        bitmap_filter.set_range(1U, 12U);
+        range_filter.set_cv29(cv29);
+
+        for (uint16 byte0 = 0x80U; byte0 <= 0xBFU; byte0++)
+        {
+            for (uint16 byte1 = 0U; byte1 <= 0xFFU; byte1++)
+            {
+                const uint8 bytes[] = { static_cast<uint8>(byte0), static_cast<uint8>(byte1), static_cast<uint8>(byte0 ^ byte1) };
+                packet_type packet1(bytes, sizeof(bytes) / sizeof(bytes[0]));
+                packet_type packet2(bytes, sizeof(bytes) / sizeof(bytes[0]));
+                const bool passed = bitmap_filter.do_filter(packet1);
+                EXPECT_EQ(passed, range_filter.do_filter(packet2));
+                nr_passed += passed ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(nr_passed > 0, true);
+    }
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if the accessory bitmap filter supports non-contiguous
+/// addresses and rejects other packet types and bad checksums.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_AccessoryBitmapFilter_2)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::accessory_bitmap_filter<packet_type>;
+
+    constexpr uint8 cv29 = dcc::cfg::kBitMask_Cv29_OutputAddressMethod;
+    filter_type filter;
+    filter.set_cv29(cv29);
+    filter.set(1U);
+    filter.set_range(2045U, 2048U);
+    filter.set(700U);
+
+    // basic accessory packet for output address
+    auto basic = [](uint16 address, bool bad_checksum) {
+        const uint16 idx = static_cast<uint16>((address + 3U) & 0x7FFU);
+        const uint8 byte0 = static_cast<uint8>(0x80U | ((idx >> 2U) & 0x3FU));
+        const uint8 byte1 = static_cast<uint8>(0x80U | ((~(idx >> 4U)) & 0x70U) | ((idx & 0x03U) << 1U));
+        const uint8 bytes[] = { byte0, byte1, static_cast<uint8>(byte0 ^ byte1 ^ (bad_checksum ? 1U : 0U)) };
+        return packet_type(bytes, sizeof(bytes) / sizeof(bytes[0]));
+    };
+
+    const uint16 passing[] = { 1U, 700U, 2045U, 2046U, 2047U, 2048U };
+    for (uint16 address : passing)
+    {
+        packet_type packet = basic(address, false);
+        EXPECT_EQ(packet.get_address(cv29), address);
+        EXPECT_EQ(filter.do_filter(packet), true);
+        packet_type bad = basic(address, true);
+        EXPECT_EQ(filter.do_filter(bad), false);
+    }
+    const uint16 failing[] = { 2U, 5U, 699U, 701U, 2044U };
+    for (uint16 address : failing)
+    {
+        packet_type packet = basic(address, false);
+        EXPECT_EQ(filter.do_filter(packet), false);
+    }
+
+    // locomotive and idle packets
+    const uint8 loco[] = { 0x01U, 0x3FU, 0x3EU };
+    const uint8 idle[] = { 0xFFU, 0x00U, 0xFFU };
+    packet_type loco_packet(loco, sizeof(loco) / sizeof(loco[0]));
+    packet_type idle_packet(idle, sizeof(idle) / sizeof(idle[0]));
+    EXPECT_EQ(filter.do_filter(loco_packet), false);
+    EXPECT_EQ(filter.do_filter(idle_packet), false);
+
+    // remove an address
+    filter.set(700U, false);
+    packet_type packet = basic(700U, false);
+    EXPECT_EQ(filter.test(700U), false);
+    EXPECT_EQ(filter.do_filter(packet), false);
+    packet_type packet1 = basic(1U, false);
+    EXPECT_EQ(filter.do_filter(packet1), true);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if CV access instructions and reset packets pass the repeat
+/// filter, and if the accessory bitmap filter lets service mode packets pass
+/// in service mode only (three reset packets in a row, no other packets).
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_Programming_1)
+{
+    using packet_type = dcc::packet<6>;
+    using repeat_filter_type = dcc::repeat_filter<packet_type, 4>;
+    using bitmap_filter_type = dcc::accessory_bitmap_filter<packet_type>;
+
+    // POM basic accessory decoder 1: write CV 29 = 0x80
+    const uint8 pom_bytes[] = { 0x81, 0xF0, 0xEC, 0x1C, 0x80, 0x01 };
+    // service mode direct: write CV 1 = 3
+    const uint8 service_bytes[] = { 0x7C, 0x00, 0x03, 0x7F };
+    const uint8 reset_bytes[] = { 0x00, 0x00, 0x00 };
+    // multi function packet for address 3
+    const uint8 loco_bytes[] = { 0x03, 0x3F, 0x80, 0xBC };
+    packet_type pom(pom_bytes, sizeof(pom_bytes));
+    packet_type service(service_bytes, sizeof(service_bytes));
+    packet_type reset(reset_bytes, sizeof(reset_bytes));
+    packet_type loco(loco_bytes, sizeof(loco_bytes));
+
+    EXPECT_EQ(pom.is_ops_mode_cv_access(), true);
+    EXPECT_EQ(pom.is_service_mode(), false);
+    EXPECT_EQ(pom.get_cv_access_index(), uint8{ 2 });
+    EXPECT_EQ(service.is_ops_mode_cv_access(), false);
+    EXPECT_EQ(service.is_service_mode(), true);
+    EXPECT_EQ(service.is_cv_access(), true);
+    EXPECT_EQ(service.get_cv_access_index(), uint8{ 0 });
+    EXPECT_EQ(reset.is_reset(), true);
+    EXPECT_EQ(loco.is_cv_access(), false);
+
+    repeat_filter_type repeat_filter(100U);
+    hal::stubs::millis = 1000U;
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(repeat_filter.do_filter(pom), true);
+        EXPECT_EQ(repeat_filter.do_filter(reset), true);
+    }
+    EXPECT_EQ(repeat_filter.do_filter(loco), true);
+    EXPECT_EQ(repeat_filter.do_filter(loco), false);
+
+    bitmap_filter_type bitmap_filter;
+    bitmap_filter.set(1U);
+    EXPECT_EQ(bitmap_filter.do_filter(pom), true);
+    EXPECT_EQ(bitmap_filter.do_filter(service), false);
+    EXPECT_EQ(bitmap_filter.do_filter(reset), false);
+    bitmap_filter.enable_service_mode(true);
+    // service mode instructions need three reset packets in a row
+    EXPECT_EQ(bitmap_filter.do_filter(service), false);
+    EXPECT_EQ(bitmap_filter.do_filter(reset), true);
+    EXPECT_EQ(bitmap_filter.do_filter(reset), true);
+    EXPECT_EQ(bitmap_filter.is_service_mode(), false);
+    EXPECT_EQ(bitmap_filter.do_filter(service), false);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(bitmap_filter.do_filter(reset), true);
+    }
+    EXPECT_EQ(bitmap_filter.is_service_mode(), true);
+    EXPECT_EQ(bitmap_filter.do_filter(service), true);
+    EXPECT_EQ(bitmap_filter.do_filter(service), true);
+    EXPECT_EQ(bitmap_filter.do_filter(loco), false);
+    // a packet for another address ends service mode
+    EXPECT_EQ(bitmap_filter.is_service_mode(), false);
+    EXPECT_EQ(bitmap_filter.do_filter(service), false);
+    // early reject: the first byte of an idle packet ends service mode
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(bitmap_filter.do_filter(reset), true);
+    }
+    EXPECT_EQ(bitmap_filter.may_pass(0x7CU), true);
+    EXPECT_EQ(bitmap_filter.may_pass(0xFFU), false);
+    EXPECT_EQ(bitmap_filter.may_pass(0x7CU), false);
+    EXPECT_EQ(bitmap_filter.do_filter(service), false);
+    bitmap_filter.clear();
+    EXPECT_EQ(bitmap_filter.do_filter(pom), false);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Test if the loco bitmap filter lets packets pass for 7 bit and
+/// 14 bit addresses and if the number of pages is limited.
+// -----------------------------------------------------------------------
+TEST(Ut_Filter, filter_LocoBitmapFilter_1)
+{
+    using packet_type = dcc::packet<6>;
+    using filter_type = dcc::loco_bitmap_filter<packet_type, 2>;
+
+    filter_type filter;
+    EXPECT_EQ(filter.set(3U), true);
+    EXPECT_EQ(filter.set(1000U), true);
+    EXPECT_EQ(filter.set(1001U), true);
+    EXPECT_EQ(filter.set(10239U), true);
+    // a third page is not available
+    EXPECT_EQ(filter.set(5000U), false);
+    EXPECT_EQ(filter.set(10240U), false);
+
+    auto loco = [](uint16 address) {
+        if (address < 128U)
+        {
+            const uint8 bytes[] = { static_cast<uint8>(address), 0x3FU, static_cast<uint8>(address ^ 0x3FU) };
+            return packet_type(bytes, sizeof(bytes) / sizeof(bytes[0]));
+        }
+        const uint8 byte0 = static_cast<uint8>(0xC0U | (address >> 8U));
+        const uint8 byte1 = static_cast<uint8>(address & 0xFFU);
+        const uint8 bytes[] = { byte0, byte1, 0x3FU, static_cast<uint8>(byte0 ^ byte1 ^ 0x3FU) };
+        return packet_type(bytes, sizeof(bytes) / sizeof(bytes[0]));
+    };
+
+    const uint16 passing[] = { 3U, 1000U, 1001U, 10239U };
+    for (uint16 address : passing)
+    {
+        packet_type packet = loco(address);
+        EXPECT_EQ(packet.get_address(0U), address);
+        EXPECT_EQ(filter.test(address), true);
+        EXPECT_EQ(filter.do_filter(packet), true);
+    }
+    const uint16 failing[] = { 0U, 4U, 127U, 999U, 1002U, 5000U, 10238U };
+    for (uint16 address : failing)
+    {
+        packet_type packet = loco(address);
+        EXPECT_EQ(filter.test(address), false);
+        EXPECT_EQ(filter.do_filter(packet), false);
+    }
+
+    // accessory packets do not pass
+    const uint8 accessory[] = { 0x81U, 0xF8U, 0x79U };
+    packet_type accessory_packet(accessory, sizeof(accessory) / sizeof(accessory[0]));
+    EXPECT_EQ(filter.do_filter(accessory_packet), false);
+
+    filter.clear();
+    packet_type packet = loco(1000U);
+    EXPECT_EQ(filter.do_filter(packet), false);
+    EXPECT_EQ(filter.set(5000U), true);
+}
+
 /**
  * @brief Intended to be called before each test.
  */
@@ -129,6 +546,14 @@ bool test_loop(void)
 
     RUN_TEST(filter_PassPrimaryAddressFilter_1);
     RUN_TEST(filter_PassAddressFilter_1);
+    RUN_TEST(filter_RepeatFilter_1);
+    RUN_TEST(filter_RepeatFilter_2);
+    RUN_TEST(filter_RepeatFilter_3);
+    RUN_TEST(filter_RepeatFilter_4);
+    RUN_TEST(filter_AccessoryBitmapFilter_1);
+    RUN_TEST(filter_AccessoryBitmapFilter_2);
+    RUN_TEST(filter_Programming_1);
+    RUN_TEST(filter_LocoBitmapFilter_1);
 
     (void)UNITY_END();
 
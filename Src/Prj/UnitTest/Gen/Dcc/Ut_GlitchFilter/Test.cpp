@@ -0,0 +1,188 @@
+/**
+ * @file Ut_GlitchFilter/Test.cpp
+ *
+ * @brief Unit tests for dcc::glitch_filter of Gen/Dcc/GlitchFilter.h
+ *
+ * Compares valid packets per second of the bit extractor with and without glitch filter on
+ * waveforms from dcc::encoder with spikes.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+#include <Hal/Serial.h>
+#include <unity_adapt.h>
+#include <Dcc/GlitchFilter.h>
+#include <Dcc/Encoder.h>
+#include <Dcc/BitExtractor.h>
+#include <Dcc/PacketExtractor.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_extractor_type = dcc::packet_extractor<>;
+using bit_extractor_type = dcc::bit_extractor<>;
+using packet_type = packet_extractor_type::packet_type;
+using encoder_type = dcc::encoder<packet_type>;
+using glitch_filter_type = dcc::glitch_filter<bit_extractor_type, 20U, 2U>;
+using recorder_filter_type = dcc::glitch_filter<DeltaRecorderClass, 20U, 2U>;
+
+// -----------------------------------------------------------------------
+/// Returns the sum of the time deltas [us]
+// -----------------------------------------------------------------------
+static uint32 track_time(const std::vector<uint16>& deltas)
+{
+  uint32 t = 0U;
+  for (uint16 dt : deltas)
+  {
+    t += dt;
+  }
+  return t;
+}
+
+// -----------------------------------------------------------------------
+/// @brief A spike within a half bit is merged into the half bit
+// -----------------------------------------------------------------------
+TEST(Ut_GlitchFilter, merge)
+{
+  DeltaRecorderClass rec;
+  recorder_filter_type filter(rec);
+
+  // half bits 58, 58 (30 + 5 + 23), 100 (60 + 4 + 36), 100, 58
+  const uint16 deltas[] = { 58, 30, 5, 23, 60, 4, 36, 100, 58 };
+  filter.execute_many(deltas, sizeof(deltas) / sizeof(deltas[0]));
+
+  // the last half bit is forwarded with the next edge
+  const std::vector<uint32> expected = { 58, 58, 100, 100 };
+  EXPECT_EQ(rec.deltas == expected, true);
+  EXPECT_EQ(filter.get_glitch_count(), uint16{ 2 });
+  EXPECT_EQ(filter.get_reset_count(), uint16{ 0 });
+
+  filter.execute(100);
+  EXPECT_EQ(rec.deltas.size(), static_cast<size_t>(5));
+  EXPECT_EQ(rec.deltas.back(), uint32{ 58 });
+
+  // a spike close to the start of a half bit starts the next half bit: 58, 100 (3 + 4 + 93)
+  filter.execute(58);
+  const uint16 deltas2[] = { 3, 4, 93 };
+  filter.execute_many(deltas2, sizeof(deltas2) / sizeof(deltas2[0]));
+  // a spike close to the end of a half bit ends the half bit: 100, 58 (40 + 4 + 14)
+  const uint16 deltas3[] = { 40, 4, 14, 100 };
+  filter.execute_many(deltas3, sizeof(deltas3) / sizeof(deltas3[0]));
+  const std::vector<uint32> expected2 = { 58, 58, 100, 100, 58, 100, 58, 100, 58 };
+  EXPECT_EQ(rec.deltas == expected2, true);
+  EXPECT_EQ(filter.get_glitch_count(), uint16{ 4 });
+  EXPECT_EQ(filter.get_reset_count(), uint16{ 0 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Too many glitches within a bit reset the bit extractor
+// -----------------------------------------------------------------------
+TEST(Ut_GlitchFilter, limit)
+{
+  DeltaRecorderClass rec;
+  recorder_filter_type filter(rec);
+
+  // two glitches within two half bits are tolerated
+  const uint16 deltas1[] = { 58, 30, 2, 26, 30, 2, 26, 58 };
+  filter.execute_many(deltas1, sizeof(deltas1) / sizeof(deltas1[0]));
+  EXPECT_EQ(filter.get_reset_count(), uint16{ 0 });
+  const std::vector<uint32> expected1 = { 58, 58, 58 };
+  EXPECT_EQ(rec.deltas == expected1, true);
+
+  // the third glitch within two half bits forwards an invalid time delta
+  rec.deltas.clear();
+  const uint16 deltas2[] = { 30, 2, 26, 30, 2, 6, 2, 22, 58 };
+  filter.execute_many(deltas2, sizeof(deltas2) / sizeof(deltas2[0]));
+  EXPECT_EQ(filter.get_reset_count(), uint16{ 1 });
+  EXPECT_EQ(filter.get_glitch_count(), uint16{ 5 });
+  const std::vector<uint32> expected2 = { 58, 58, 0, 22 };
+  EXPECT_EQ(rec.deltas == expected2, true);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Valid packets per second with and without glitch filter, on a clean waveform and on
+/// waveforms with spikes
+// -----------------------------------------------------------------------
+TEST(Ut_GlitchFilter, packets_per_second)
+{
+  constexpr int kNrRefreshs = 4;
+  const uint16 spike_rates[] = { 0U, 66U, 328U, 655U };
+
+  for (uint16 rate : spike_rates)
+  {
+    encoder_type::config_type cfg = encoder_type::default_config();
+    cfg.jitter_us = 2U;
+    cfg.cutout_us = 464U;
+    cfg.spike_rate = rate;
+    cfg.spike_us = 8U;
+    encoder_type enc(cfg);
+    const std::vector<uint16> deltas = make_waveform(enc, kNrRefreshs);
+    const uint32 nr_spikes = enc.get_spike_count();
+    const uint32 t = track_time(deltas);
+
+    PacketCounterClass handler1;
+    packet_extractor_type pe1(handler1);
+    bit_extractor_type be1(pe1);
+    be1.execute_many(deltas.data(), deltas.size());
+
+    PacketCounterClass handler2;
+    packet_extractor_type pe2(handler2);
+    bit_extractor_type be2(pe2);
+    glitch_filter_type filter(be2);
+    filter.execute_many(deltas.data(), deltas.size());
+
+    const uint32 pps1 = static_cast<uint32>((static_cast<unsigned long long>(handler1.nr_checksum_ok) * 1000000ULL) / t);
+    const uint32 pps2 = static_cast<uint32>((static_cast<unsigned long long>(handler2.nr_checksum_ok) * 1000000ULL) / t);
+    if (rate == 0U)
+    {
+      // no loss on a clean waveform
+      EXPECT_EQ(handler1.nr_checksum_ok, static_cast<uint32>(kNrRefreshs * 256));
+      EXPECT_EQ(handler2.nr_checksum_ok, static_cast<uint32>(kNrRefreshs * 256));
+      EXPECT_EQ(filter.get_glitch_count(), uint16{ 0 });
+    }
+    else
+    {
+      EXPECT_EQ(handler2.nr_checksum_ok > handler1.nr_checksum_ok, true);
+      // near-lossless with glitch filter: at least 98 % of the packets
+      EXPECT_EQ(handler2.nr_checksum_ok * 100U >= static_cast<uint32>(kNrRefreshs * 256 * 98), true);
+    }
+    hal::serial::print("spike rate ");
+    hal::serial::print(static_cast<uint32>(rate));
+    hal::serial::print("/65536, ");
+    hal::serial::print(nr_spikes);
+    hal::serial::print(" spikes: ");
+    hal::serial::print(pps1);
+    hal::serial::print(" valid packets/s without, ");
+    hal::serial::print(pps2);
+    hal::serial::print(" with glitch filter (");
+    hal::serial::print(static_cast<uint32>(filter.get_reset_count()));
+    hal::serial::println(" resets)");
+  }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(merge);
+  RUN_TEST(limit);
+  RUN_TEST(packets_per_second);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file Ut_HalfBitHistogram/Test.cpp
+ *
+ * @brief Unit tests for dcc::halfbit_histogram of Gen/Dcc/HalfBitHistogram.h
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <initializer_list>
+#include <unity_adapt.h>
+#include <Dcc/HalfBitHistogram.h>
+#include <Dcc/Encoder.h>
+#include <Util/Array.h>
+#include <Ut_Dcc_Helper.h>
+
+using histogram_type = dcc::halfbit_histogram<>;
+using metrics_array = util::array<uint16, histogram_type::kNrMetrics>;
+
+// -----------------------------------------------------------------------
+/// @brief Time deltas are counted in bins of 4 us from 40 us to 140 us, below and above
+// -----------------------------------------------------------------------
+TEST(Ut_HalfBitHistogram, bins)
+{
+  histogram_type hist;
+  histogram_type::counters_type c;
+
+  EXPECT_EQ(histogram_type::kNrBins, uint8{ 27 });
+  hist.add(0U);
+  hist.add(39U);
+  hist.add(40U);
+  hist.add(43U);
+  hist.add(44U);
+  hist.add(58U);
+  hist.add(139U);
+  hist.add(140U);
+  hist.add(10000U);
+  hist.add_packet();
+  hist.take(c);
+
+  EXPECT_EQ(c.bins[0], uint16{ 2 });
+  EXPECT_EQ(c.bins[1], uint16{ 2 });
+  EXPECT_EQ(c.bins[2], uint16{ 1 });
+  EXPECT_EQ(c.bins[5], uint16{ 1 });
+  EXPECT_EQ(c.bins[25], uint16{ 1 });
+  EXPECT_EQ(c.bins[26], uint16{ 2 });
+  EXPECT_EQ(c.nr_packets, uint16{ 1 });
+
+  // take() starts a new measurement window
+  hist.add(58U);
+  hist.take(c);
+  EXPECT_EQ(c.bins[0], uint16{ 0 });
+  EXPECT_EQ(c.bins[5], uint16{ 1 });
+  EXPECT_EQ(c.nr_packets, uint16{ 0 });
+  hist.take(c);
+  EXPECT_EQ(c.bins[5], uint16{ 0 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Metrics of a clean waveform from dcc::encoder
+// -----------------------------------------------------------------------
+TEST(Ut_HalfBitHistogram, metrics_clean)
+{
+  histogram_type hist;
+  histogram_type::counters_type c;
+  metrics_array metrics;
+  dcc::encoder<> enc;
+
+  for (int i = 0; i < 150; i++)
+  {
+    enc.encode(make_packet({ 0x81, 0xF8 }), [&hist](uint16 dt) { hist.add(dt); });
+    hist.add_packet();
+  }
+  hist.take(c);
+  histogram_type::evaluate(c, 1000U, metrics);
+
+  // 58 us is in bin 56 - 59 us, 100 us in bin 100 - 103 us
+  EXPECT_EQ(metrics[histogram_type::kMeanShort], uint16{ 580 });
+  EXPECT_EQ(metrics[histogram_type::kMeanLong], uint16{ 1020 });
+  EXPECT_EQ(metrics[histogram_type::kAsymmetry], uint16{ 0 });
+  EXPECT_EQ(metrics[histogram_type::kOutOfSpec], uint16{ 0 });
+  EXPECT_EQ(metrics[histogram_type::kPacketsPerSecond], uint16{ 150 });
+
+  histogram_type::evaluate(c, 2000U, metrics);
+  EXPECT_EQ(metrics[histogram_type::kPacketsPerSecond], uint16{ 75 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Asymmetry of "1" bits and time deltas out of spec
+// -----------------------------------------------------------------------
+TEST(Ut_HalfBitHistogram, metrics_asymmetry_out_of_spec)
+{
+  histogram_type hist;
+  histogram_type::counters_type c;
+  metrics_array metrics;
+
+  // "1" bits with halves of 60 us and 56 us: asymmetry 2 us
+  for (int i = 0; i < 100; i++)
+  {
+    hist.add(60U);
+    hist.add(56U);
+  }
+  // 4 of 200 time deltas are out of spec
+  hist.add(30U);
+  hist.add(75U);
+  hist.add(76U);
+  hist.add(70U);
+  hist.take(c);
+  histogram_type::evaluate(c, 1000U, metrics);
+
+  EXPECT_EQ(metrics[histogram_type::kAsymmetry], uint16{ 20 });
+  EXPECT_EQ(metrics[histogram_type::kOutOfSpec], uint16{ (1000U * 4U) / 204U });
+  EXPECT_EQ(metrics[histogram_type::kMeanShort], uint16{ 600 });
+  EXPECT_EQ(metrics[histogram_type::kMeanLong], uint16{ 0 });
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(bins);
+  RUN_TEST(metrics_clean);
+  RUN_TEST(metrics_asymmetry_out_of_spec);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file Ut_LocoTable/Test.cpp
+ *
+ * @brief Unit tests for dcc::loco_table of Gen/Dcc/LocoTable.h
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <initializer_list>
+#include <unity_adapt.h>
+#include <Dcc/LocoTable.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_type = dcc::packet<6>;
+using table_type = dcc::loco_table<packet_type, 16U>;
+using entry_type = table_type::entry_type;
+
+// -----------------------------------------------------------------------
+/// Decode a packet with bytes into table t
+// -----------------------------------------------------------------------
+static bool update(table_type& t, std::initializer_list<uint8> bytes)
+{
+  packet_type pkt = make_packet(bytes);
+  return t.update(pkt);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Speed and direction with 126 and 28 speed steps
+// -----------------------------------------------------------------------
+TEST(Ut_LocoTable, speed)
+{
+  table_type t;
+
+  // address 3, 126 speed steps: forward, step 10 (S = 11)
+  EXPECT_EQ(update(t, { 0x03, 0x3F, 0x8B }), true);
+  const entry_type* e = t.find(3U);
+  EXPECT_EQ(e != nullptr, true);
+  EXPECT_EQ(e->speed, uint8{ 10 });
+  EXPECT_EQ(e->is_forward(), true);
+  EXPECT_EQ(e->is_speed28(), false);
+
+  // reverse, emergency stop
+  EXPECT_EQ(update(t, { 0x03, 0x3F, 0x01 }), true);
+  EXPECT_EQ(e->speed, table_type::kEmergencyStop);
+  EXPECT_EQ(e->is_forward(), false);
+
+  // 28 speed steps: 011DCSSSS forward, CSSSS = 0 0101 -> 10 -> step 7
+  EXPECT_EQ(update(t, { 0x03, 0x65 }), true);
+  EXPECT_EQ(e->speed, uint8{ 7 });
+  EXPECT_EQ(e->is_forward(), true);
+  EXPECT_EQ(e->is_speed28(), true);
+  // C = 1: step 8
+  EXPECT_EQ(update(t, { 0x03, 0x75 }), true);
+  EXPECT_EQ(e->speed, uint8{ 8 });
+  // 14 bit address 1234 (0xC4 0xD2), reverse stop
+  EXPECT_EQ(update(t, { 0xC4, 0xD2, 0x40 }), true);
+  e = t.find(1234U);
+  EXPECT_EQ(e != nullptr, true);
+  EXPECT_EQ(e->speed, uint8{ 0 });
+  EXPECT_EQ(e->is_forward(), false);
+  EXPECT_EQ(t.size(), uint16{ 2 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Function groups F0 - F28
+// -----------------------------------------------------------------------
+TEST(Ut_LocoTable, functions)
+{
+  table_type t;
+
+  // F0 and F2: 100 1 0010
+  EXPECT_EQ(update(t, { 0x05, 0x92 }), true);
+  // F5 and F8: 1011 1001
+  EXPECT_EQ(update(t, { 0x05, 0xB9 }), true);
+  // F12: 1010 1000
+  EXPECT_EQ(update(t, { 0x05, 0xA8 }), true);
+  // F13 and F20
+  EXPECT_EQ(update(t, { 0x05, 0xDE, 0x81 }), true);
+  // F28
+  EXPECT_EQ(update(t, { 0x05, 0xDF, 0x80 }), true);
+  const entry_type* e = t.find(5U);
+  EXPECT_EQ(e != nullptr, true);
+  const uint32 expected = (1UL << 0U) | (1UL << 2U) | (1UL << 5U) | (1UL << 8U) | (1UL << 12U) |
+                          (1UL << 13U) | (1UL << 20U) | (1UL << 28U);
+  EXPECT_EQ(e->functions, expected);
+  EXPECT_EQ(e->get_function(2U), true);
+  EXPECT_EQ(e->get_function(3U), false);
+
+  // F0 off, F1 - F4 off: the other groups are kept
+  EXPECT_EQ(update(t, { 0x05, 0x80 }), true);
+  EXPECT_EQ(e->functions, static_cast<uint32>(expected & ~0x1FUL));
+
+  // accessory packets, idle packets and unknown instructions are not decoded
+  EXPECT_EQ(update(t, { 0x81, 0xF8 }), false);
+  EXPECT_EQ(update(t, { 0xFF, 0x00 }), false);
+  EXPECT_EQ(update(t, { 0x05, 0xE0, 0x00 }), false);
+  EXPECT_EQ(t.size(), uint16{ 1 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief Changed entries are returned by pop_dirty() in the order of their first change
+// -----------------------------------------------------------------------
+TEST(Ut_LocoTable, dirty)
+{
+  table_type t;
+
+  (void) update(t, { 0x07, 0x3F, 0x85 });
+  (void) update(t, { 0x03, 0x3F, 0x85 });
+  (void) update(t, { 0x07, 0x3F, 0x86 });
+  EXPECT_EQ(t.get_nr_dirty(), uint16{ 2 });
+  const entry_type* e = t.pop_dirty();
+  EXPECT_EQ(e->address, static_cast<table_type::address_type>(7));
+  EXPECT_EQ(e->speed, uint8{ 5 });
+  e = t.pop_dirty();
+  EXPECT_EQ(e->address, static_cast<table_type::address_type>(3));
+  EXPECT_EQ(t.pop_dirty() == nullptr, true);
+
+  // a repetition does not change the entry
+  (void) update(t, { 0x07, 0x3F, 0x86 });
+  EXPECT_EQ(t.get_nr_dirty(), uint16{ 0 });
+  (void) update(t, { 0x07, 0x3F, 0x87 });
+  EXPECT_EQ(t.get_nr_dirty(), uint16{ 1 });
+  EXPECT_EQ(t.pop_dirty()->speed, uint8{ 6 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief A full table drops new addresses and keeps the known ones
+// -----------------------------------------------------------------------
+TEST(Ut_LocoTable, full)
+{
+  table_type t;
+
+  for (uint8 a = 1U; a <= 20U; a++)
+  {
+    (void) update(t, { a, 0x3F, static_cast<uint8>(0x80U | (a + 1U)) });
+  }
+  EXPECT_EQ(t.size(), table_type::kCapacity);
+  EXPECT_EQ(t.get_overflow_count(), uint16{ 4 });
+  EXPECT_EQ(t.get_nr_dirty(), table_type::kCapacity);
+  for (uint8 a = 1U; a <= 16U; a++)
+  {
+    const entry_type* e = t.find(a);
+    EXPECT_EQ(e != nullptr, true);
+    EXPECT_EQ(e->speed, a);
+  }
+  EXPECT_EQ(t.find(17U) == nullptr, true);
+
+  // each entry is in the list of dirty entries once
+  uint16 n = 0U;
+  while (t.pop_dirty() != nullptr)
+  {
+    n++;
+  }
+  EXPECT_EQ(n, table_type::kCapacity);
+}
+
+// -----------------------------------------------------------------------
+/// @brief A fleet of 300 addresses (7 and 14 bit) in a table with 512 entries
+// -----------------------------------------------------------------------
+TEST(Ut_LocoTable, fleet)
+{
+  using fleet_type = dcc::loco_table<packet_type, 512U>;
+  static fleet_type t;
+
+  for (uint16 a = 1U; a <= 300U; a++)
+  {
+    packet_type pkt = (a < 128U) ? make_packet({ static_cast<uint8>(a), 0x3F, 0x90 }) :
+                                   make_packet({ static_cast<uint8>(0xC0U | (a >> 8U)), static_cast<uint8>(a), 0x3F, 0x90 });
+    EXPECT_EQ(t.update(pkt), true);
+  }
+  EXPECT_EQ(t.size(), uint16{ 300 });
+  EXPECT_EQ(t.get_overflow_count(), uint16{ 0 });
+  for (uint16 a = 1U; a <= 300U; a++)
+  {
+    const fleet_type::entry_type* e = t.find(a);
+    EXPECT_EQ(e != nullptr, true);
+    EXPECT_EQ(e->address, a);
+    EXPECT_EQ(e->speed, uint8{ 15 });
+  }
+  EXPECT_EQ(t.find(301U) == nullptr, true);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(speed);
+  RUN_TEST(functions);
+  RUN_TEST(dirty);
+  RUN_TEST(full);
+  RUN_TEST(fleet);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -395,6 +395,51 @@ TEST(Ut_Packet, packet_014_address_BasicAccessory_OutputAddress_2048)
     test_address_BasicAccessory_OutputAddress(10);
 }
 
+//-------------------------------------------------------------------------
+TEST(Ut_Packet, packet_015_add_byte)
+{
+    dcc::packet<3> packet;
+
+    EXPECT_EQ(packet.add_byte(0x81U), true);
+    EXPECT_EQ(packet.add_byte(0xF8U), true);
+    EXPECT_EQ(packet.add_byte(0x79U), true);
+    // packet is full
+    EXPECT_EQ(packet.add_byte(0x55U), false);
+    EXPECT_EQ(packet.getNrBytes(), 3u);
+    EXPECT_EQ(packet.refByte(0), static_cast<uint8>(0x81U));
+    EXPECT_EQ(packet.refByte(1), static_cast<uint8>(0xF8U));
+    EXPECT_EQ(packet.refByte(2), static_cast<uint8>(0x79U));
+
+    // same content as bit-wise assembly
+    dcc::packet<3> packet_bits;
+    addByteToPacket(packet_bits, 0x81U);
+    addByteToPacket(packet_bits, 0xF8U);
+    addByteToPacket(packet_bits, 0x79U);
+    EXPECT_EQ(packet == packet_bits, true);
+}
+
+//-------------------------------------------------------------------------
+/// The checksum state from set_checksum_ok() is used by decode() instead of testChecksum()
+TEST(Ut_Packet, packet_016_checksum_state)
+{
+    const uint8 bytes[] = { 0x81, 0xF8, 0x79 };
+    dcc::packet<6> packet(bytes, sizeof(bytes));
+
+    EXPECT_EQ(packet.is_checksum_ok(), true);
+    EXPECT_EQ(packet.get_type(), packet_type::BasicAccessory);
+
+    dcc::packet<6> packet_bad(bytes, sizeof(bytes));
+    packet_bad.set_checksum_ok(false);
+    EXPECT_EQ(packet_bad.is_checksum_ok(), false);
+    EXPECT_EQ(packet_bad.get_type(), packet_type::Invalid);
+
+    // adding bytes invalidates the checksum state
+    dcc::packet<6> packet_add(bytes, 2U);
+    packet_add.set_checksum_ok(false);
+    EXPECT_EQ(packet_add.add_byte(0x79U), true);
+    EXPECT_EQ(packet_add.is_checksum_ok(), true);
+}
+
 void setUp(void)
 {
 }
@@ -435,6 +480,8 @@ bool test_loop(void)
     RUN_TEST(packet_014_address_BasicAccessory_OutputAddress_2046);
     RUN_TEST(packet_014_address_BasicAccessory_OutputAddress_2047);
     RUN_TEST(packet_014_address_BasicAccessory_OutputAddress_2048);
+    RUN_TEST(packet_015_add_byte);
+    RUN_TEST(packet_016_checksum_state);
 
     (void)UNITY_END();
 
@@ -12,9 +12,13 @@
 
 #include <unity_adapt.h>
 #include <array>
+#include <vector>
 #include <Dcc/PacketExtractor.h>
+#include <Dcc/BitExtractor.h>
 
 typedef dcc::packet_extractor<> packet_extractor_type;
+typedef dcc::bit_extractor<> bit_extractor_type;
+typedef packet_extractor_type::packet_type packet_type;
 
 // -----------------------------------------------------------------------
 /// A handler class for new packets.
@@ -33,6 +37,95 @@ public:
   }
 };
 
+// -----------------------------------------------------------------------
+/// A handler class that records all received packets.
+// -----------------------------------------------------------------------
+class PacketRecorderClass : public packet_extractor_type::handler_ifc
+{
+public:
+  std::vector<packet_type> packets;
+  virtual void packet_received(packet_type& pkt) override
+  {
+    packets.push_back(pkt);
+  }
+};
+
+// -----------------------------------------------------------------------
+/// A handler class that provides packet slots so that packets are assembled in place.
+// -----------------------------------------------------------------------
+class PacketSlotHandlerClass : public packet_extractor_type::handler_ifc
+{
+public:
+  packet_type slots[2];
+  int idx;
+  int nr_in_place;
+  std::vector<packet_type> packets;
+  PacketSlotHandlerClass() : idx(0), nr_in_place(0) {}
+  virtual packet_type* get_packet_slot() override
+  {
+    return &slots[idx];
+  }
+  virtual void packet_received(packet_type& pkt) override
+  {
+    if (&pkt == &slots[idx])
+    {
+      nr_in_place++;
+    }
+    packets.push_back(pkt);
+    idx = 1 - idx;
+  }
+};
+
+// -----------------------------------------------------------------------
+/// A handler class that records accessory packets and rejects all other packets after their 
+/// first byte.
+// -----------------------------------------------------------------------
+class AccessoryRecorderClass : public packet_extractor_type::handler_ifc
+{
+public:
+  std::vector<packet_type> packets;
+  int nr_rejected;
+  AccessoryRecorderClass() : nr_rejected(0) {}
+  virtual bool accept_first_byte(uint8 byte0) override
+  {
+    const bool accept = ((byte0 & 0xC0U) == 0x80U);
+    if (!accept)
+    {
+      nr_rejected++;
+    }
+    return accept;
+  }
+  virtual void packet_received(packet_type& pkt) override
+  {
+    packets.push_back(pkt);
+  }
+};
+
+typedef dcc::packet_extractor<10, packet_extractor_type::handler_ifc, true> early_reject_packet_extractor_type;
+typedef dcc::bit_extractor<dcc::bit_extractor_constants<>, early_reject_packet_extractor_type> early_reject_bit_extractor_type;
+
+// -----------------------------------------------------------------------
+/// Append the time deltas of a packet (preamble, bytes, end bit) to deltas.
+// -----------------------------------------------------------------------
+static void append_packet(std::vector<uint16_t>& deltas, std::initializer_list<uint8> bytes, int preamble = 14)
+{
+  auto one = [&deltas]() { deltas.push_back(58); deltas.push_back(58); };
+  auto zero = [&deltas]() { deltas.push_back(100); deltas.push_back(100); };
+  for (int i = 0; i < preamble; i++)
+  {
+    one();
+  }
+  for (uint8 b : bytes)
+  {
+    zero();
+    for (int bit = 7; bit >= 0; bit--)
+    {
+      if ((b >> bit) & 1U) { one(); } else { zero(); }
+    }
+  }
+  one();
+}
+
 // -----------------------------------------------------------------------
 /// @brief Test an invalid preamble (just a single 1 is received)
 // -----------------------------------------------------------------------
@@ -144,6 +237,228 @@ TEST(Ut_PacketExtractor, packetextractor_preamble_valid_10_bit)
   EXPECT_EQ(packet.refByte(1) == packethandler.lastpacket.refByte(1), true);
 }
 
+// -----------------------------------------------------------------------
+/// @brief bit_extractor::execute_many gives the same packets as bit_extractor::execute
+// -----------------------------------------------------------------------
+TEST(Ut_BitExtractor, execute_many_equals_execute)
+{
+  std::vector<uint16_t> deltas;
+  append_packet(deltas, { 0x81, 0xF8, 0x79 });
+  append_packet(deltas, { 0xFF, 0x00, 0xFF });
+  // disturbed packet: invalid half bit in the middle of the second byte
+  append_packet(deltas, { 0x03, 0x3F, 0x10, 0x2C });
+  deltas[deltas.size() - 30U] = 30U;
+  append_packet(deltas, { 0x03, 0x3F, 0x10, 0x2C }, 10);
+  // too short preamble
+  append_packet(deltas, { 0x81, 0xF8, 0x79 }, 9);
+  append_packet(deltas, { 0xBF, 0x89, 0x36 }, 20);
+
+  PacketRecorderClass single_handler;
+  packet_extractor_type single_pe(single_handler);
+  bit_extractor_type single_be(single_pe);
+  for (uint16_t dt : deltas)
+  {
+    single_be.execute(dt);
+  }
+
+  PacketRecorderClass many_handler;
+  packet_extractor_type many_pe(many_handler);
+  bit_extractor_type many_be(many_pe);
+  // pointer interface, split into two chunks to cross a packet boundary
+  const size_t half = deltas.size() / 2U;
+  many_be.execute_many(deltas.data(), half);
+  many_be.execute_many(deltas.data() + half, deltas.size() - half);
+
+  PacketRecorderClass it_handler;
+  packet_extractor_type it_pe(it_handler);
+  bit_extractor_type it_be(it_pe);
+  // iterator interface
+  it_be.execute_many(deltas.begin(), deltas.end());
+
+  EXPECT_EQ(single_handler.packets.size(), static_cast<size_t>(4));
+  EXPECT_EQ(many_handler.packets.size(), single_handler.packets.size());
+  EXPECT_EQ(it_handler.packets.size(), single_handler.packets.size());
+  for (size_t i = 0; i < single_handler.packets.size(); i++)
+  {
+    const packet_type& expected = single_handler.packets[i];
+    EXPECT_EQ(many_handler.packets[i].getNrBytes(), expected.getNrBytes());
+    EXPECT_EQ(it_handler.packets[i].getNrBytes(), expected.getNrBytes());
+    for (size_t b = 0; b < expected.getNrBytes(); b++)
+    {
+      EXPECT_EQ(many_handler.packets[i].refByte(b), expected.refByte(b));
+      EXPECT_EQ(it_handler.packets[i].refByte(b), expected.refByte(b));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------
+/// @brief Packets are assembled in the slots of the handler and give the same packets as the 
+/// extractor's own packet.
+// -----------------------------------------------------------------------
+TEST(Ut_PacketExtractor, packet_slots)
+{
+  std::vector<uint16_t> deltas;
+  append_packet(deltas, { 0x81, 0xF8, 0x79 });
+  // too short preamble
+  append_packet(deltas, { 0xFF, 0x00, 0xFF }, 9);
+  append_packet(deltas, { 0x03, 0x3F, 0x10, 0x2C });
+  append_packet(deltas, { 0xBF, 0x89, 0x36 }, 20);
+
+  PacketRecorderClass own_handler;
+  packet_extractor_type own_pe(own_handler);
+  bit_extractor_type own_be(own_pe);
+  own_be.execute_many(deltas.begin(), deltas.end());
+
+  PacketSlotHandlerClass slot_handler;
+  packet_extractor_type slot_pe(slot_handler);
+  bit_extractor_type slot_be(slot_pe);
+  slot_be.execute_many(deltas.begin(), deltas.end());
+
+  EXPECT_EQ(own_handler.packets.size(), static_cast<size_t>(3));
+  EXPECT_EQ(slot_handler.packets.size(), own_handler.packets.size());
+  EXPECT_EQ(slot_handler.nr_in_place, 3);
+  for (size_t i = 0; i < own_handler.packets.size(); i++)
+  {
+    const packet_type& expected = own_handler.packets[i];
+    EXPECT_EQ(slot_handler.packets[i].getNrBytes(), expected.getNrBytes());
+    EXPECT_EQ(slot_handler.packets[i].preamble_one_count, expected.preamble_one_count);
+    for (size_t b = 0; b < expected.getNrBytes(); b++)
+    {
+      EXPECT_EQ(slot_handler.packets[i].refByte(b), expected.refByte(b));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------
+/// @brief Packets with a bad checksum are dropped (CFG_DCC_DECODER_REJECT_BAD_CHECKSUM), packets
+/// with more than kMaxNrBytes bytes are dropped, the checksum state is stored in the packet.
+// -----------------------------------------------------------------------
+TEST(Ut_PacketExtractor, checksum_and_length)
+{
+  std::vector<uint16_t> deltas;
+  // bad checksum
+  append_packet(deltas, { 0x81, 0xF8, 0x78 });
+  append_packet(deltas, { 0x81, 0xF8, 0x79 });
+  // too long: 7 bytes
+  append_packet(deltas, { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7F });
+  append_packet(deltas, { 0x03, 0x3F, 0x10, 0x2C });
+
+  PacketRecorderClass handler;
+  packet_extractor_type pe(handler);
+  bit_extractor_type be(pe);
+  be.execute_many(deltas.begin(), deltas.end());
+
+  #if CFG_DCC_DECODER_REJECT_BAD_CHECKSUM == OPT_DCC_DECODER_REJECT_BAD_CHECKSUM_ON
+  EXPECT_EQ(handler.packets.size(), static_cast<size_t>(2));
+  EXPECT_EQ(handler.packets[0].refByte(2), static_cast<uint8>(0x79));
+  EXPECT_EQ(handler.packets[0].is_checksum_ok(), true);
+  EXPECT_EQ(handler.packets[1].getNrBytes(), static_cast<size_t>(4));
+  EXPECT_EQ(handler.packets[1].is_checksum_ok(), true);
+  #else
+  EXPECT_EQ(handler.packets.size(), static_cast<size_t>(3));
+  EXPECT_EQ(handler.packets[0].is_checksum_ok(), false);
+  EXPECT_EQ(handler.packets[1].is_checksum_ok(), true);
+  EXPECT_EQ(handler.packets[2].getNrBytes(), static_cast<size_t>(4));
+  #endif
+}
+
+// -----------------------------------------------------------------------
+/// @brief Packets that the handler rejects after the first byte are skipped until their end bit;
+/// the packets in between are received as without early reject.
+// -----------------------------------------------------------------------
+TEST(Ut_PacketExtractor, early_reject)
+{
+  std::vector<uint16_t> deltas;
+  append_packet(deltas, { 0x81, 0xF8, 0x79 });
+  // runs of 8 ones within a rejected packet
+  append_packet(deltas, { 0x03, 0xFF, 0xFF, 0x03 });
+  append_packet(deltas, { 0xFF, 0x00, 0xFF });
+  // rejected packet with a short preamble: the next packet follows directly
+  append_packet(deltas, { 0x03, 0x3F, 0x10, 0x2C }, 10);
+  append_packet(deltas, { 0xBF, 0x89, 0x36 }, 10);
+  // too long, rejected
+  append_packet(deltas, { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7F });
+  append_packet(deltas, { 0x82, 0xF9, 0x7B });
+
+  PacketRecorderClass all_handler;
+  packet_extractor_type all_pe(all_handler);
+  bit_extractor_type all_be(all_pe);
+  all_be.execute_many(deltas.begin(), deltas.end());
+
+  AccessoryRecorderClass handler;
+  early_reject_packet_extractor_type pe(handler);
+  early_reject_bit_extractor_type be(pe);
+  be.execute_many(deltas.begin(), deltas.end());
+
+  std::vector<packet_type> expected;
+  for (const packet_type& pkt : all_handler.packets)
+  {
+    if ((pkt.refByte(0) & 0xC0U) == 0x80U)
+    {
+      expected.push_back(pkt);
+    }
+  }
+  EXPECT_EQ(expected.size(), static_cast<size_t>(3));
+  EXPECT_EQ(handler.nr_rejected, 4);
+  EXPECT_EQ(handler.packets.size(), expected.size());
+  for (size_t i = 0; (i < expected.size()) && (i < handler.packets.size()); i++)
+  {
+    EXPECT_EQ(handler.packets[i].getNrBytes(), expected[i].getNrBytes());
+    EXPECT_EQ(handler.packets[i].preamble_one_count, expected[i].preamble_one_count);
+    for (size_t b = 0; b < expected[i].getNrBytes(); b++)
+    {
+      EXPECT_EQ(handler.packets[i].refByte(b), expected[i].refByte(b));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------
+/// Gives access to the state machine of bit_extractor.
+// -----------------------------------------------------------------------
+class BitExtractorProbe : public bit_extractor_type
+{
+public:
+  BitExtractorProbe(packet_extractor_type& pex) : bit_extractor_type(pex) {}
+
+  /// Returns true if the lookup tables give the same next state as the thresholds for all states.
+  bool transit_equals_thresholds(uint32 dt)
+  {
+    bool ret = true;
+    for (uint8 s = 0U; s < static_cast<uint8>(STATE_MAX_COUNT); s++)
+    {
+      const eState expected = static_cast<eState>(kTransitionMap[s][checkTick(dt)]);
+      if (transit(static_cast<eState>(s), dt) != expected)
+      {
+        ret = false;
+      }
+    }
+    return ret;
+  }
+};
+
+// -----------------------------------------------------------------------
+/// @brief The lookup tables of bit_extractor keep the thresholds of bit_extractor_constants
+/// exactly (1 us resolution), also for time differences behind the half bit table.
+// -----------------------------------------------------------------------
+TEST(Ut_BitExtractor, transition_table_equals_thresholds)
+{
+  PacketRecorderClass handler;
+  packet_extractor_type pe(handler);
+  BitExtractorProbe probe(pe);
+  uint32 nr_mismatch = 0U;
+
+  for (uint32 dt = 0U; dt <= 10100U; dt++)
+  {
+    if (!probe.transit_equals_thresholds(dt))
+    {
+      nr_mismatch++;
+    }
+  }
+  EXPECT_EQ(probe.transit_equals_thresholds(0xFFFFU), true);
+  EXPECT_EQ(probe.transit_equals_thresholds(0xFFFFFFFFUL), true);
+  EXPECT_EQ(nr_mismatch, uint32{ 0 });
+}
+
 void setUp(void)
 {
 }
@@ -164,6 +479,11 @@ bool test_loop(void)
   RUN_TEST(packetextractor_preamble_invalid_9_bit_without_packets);
   RUN_TEST(packetextractor_preamble_invalid_9_bit_with_packets);
   RUN_TEST(packetextractor_preamble_valid_10_bit);
+  RUN_TEST(execute_many_equals_execute);
+  RUN_TEST(transition_table_equals_thresholds);
+  RUN_TEST(packet_slots);
+  RUN_TEST(checksum_and_length);
+  RUN_TEST(early_reject);
 
   (void) UNITY_END();
 
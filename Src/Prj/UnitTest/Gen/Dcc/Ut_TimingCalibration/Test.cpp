@@ -0,0 +1,195 @@
+/**
+ * @file Ut_TimingCalibration/Test.cpp
+ *
+ * @brief Unit tests for dcc::timing_calibration of Gen/Dcc/TimingCalibration.h
+ *
+ * Compares valid packets per second of the bit extractor with and without timing calibration on
+ * waveforms from dcc::encoder with a skewed clock.
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+#include <Hal/Serial.h>
+#include <unity_adapt.h>
+#include <Dcc/TimingCalibration.h>
+#include <Dcc/Encoder.h>
+#include <Dcc/BitExtractor.h>
+#include <Dcc/PacketExtractor.h>
+#include <Ut_Dcc_Helper.h>
+
+using packet_extractor_type = dcc::packet_extractor<>;
+using bit_extractor_type = dcc::bit_extractor<>;
+using packet_type = packet_extractor_type::packet_type;
+using encoder_type = dcc::encoder<packet_type>;
+using calibration_type = dcc::timing_calibration<bit_extractor_type, 25U>;
+using recorder_calibration_type = dcc::timing_calibration<DeltaRecorderClass, 25U>;
+
+// -----------------------------------------------------------------------
+/// Feed a preamble of nr_short time deltas short and the first half bit of the start bit long
+// -----------------------------------------------------------------------
+template<class Calibration>
+static void feed_preamble(Calibration& cal, int nr_short, uint32 short_us, uint32 long_us)
+{
+  for (int i = 0; i < nr_short; i++)
+  {
+    cal.execute(short_us);
+  }
+  cal.execute(long_us);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Nominal preambles keep the scale factor 1.0
+// -----------------------------------------------------------------------
+TEST(Ut_TimingCalibration, nominal)
+{
+  DeltaRecorderClass rec;
+  recorder_calibration_type cal(rec);
+
+  feed_preamble(cal, 28, 58U, 100U);
+  EXPECT_EQ(cal.get_calibration_count(), uint16{ 1 });
+  EXPECT_EQ(cal.get_scale(), recorder_calibration_type::kScaleOne);
+  EXPECT_EQ(rec.deltas.size(), static_cast<size_t>(29));
+  EXPECT_EQ(rec.deltas.front(), uint32{ 58 });
+  EXPECT_EQ(rec.deltas.back(), uint32{ 100 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief A clock that is 20 % fast is scaled to nominal
+// -----------------------------------------------------------------------
+TEST(Ut_TimingCalibration, skew)
+{
+  DeltaRecorderClass rec;
+  recorder_calibration_type cal(rec);
+
+  for (int i = 0; i < 10; i++)
+  {
+    feed_preamble(cal, 30, 70U, 120U);
+  }
+  EXPECT_EQ(cal.get_calibration_count(), uint16{ 10 });
+  // 256 * 158 / 190 = 212.9
+  EXPECT_EQ((cal.get_scale() >= 210U) && (cal.get_scale() <= 215U), true);
+  rec.deltas.clear();
+  cal.execute(70U);
+  cal.execute(120U);
+  EXPECT_EQ((rec.deltas[0] >= 57U) && (rec.deltas[0] <= 59U), true);
+  EXPECT_EQ((rec.deltas[1] >= 98U) && (rec.deltas[1] <= 101U), true);
+
+  cal.reset();
+  EXPECT_EQ(cal.get_scale(), recorder_calibration_type::kScaleOne);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Runs that are no preambles are ignored, the scale factor is limited
+// -----------------------------------------------------------------------
+TEST(Ut_TimingCalibration, reject)
+{
+  DeltaRecorderClass rec;
+  recorder_calibration_type cal(rec);
+
+  // long half bits of a slow clock (-25 %) followed by a short half bit
+  feed_preamble(cal, 40, 75U, 44U);
+  // preamble followed by a stretched zero bit
+  feed_preamble(cal, 28, 58U, 5000U);
+  // preamble too short
+  feed_preamble(cal, 18, 58U, 100U);
+  EXPECT_EQ(cal.get_calibration_count(), uint16{ 0 });
+  EXPECT_EQ(cal.get_scale(), recorder_calibration_type::kScaleOne);
+
+  // a clock that is 31 % fast is limited to 25 %
+  for (int i = 0; i < 10; i++)
+  {
+    feed_preamble(cal, 30, 76U, 131U);
+  }
+  EXPECT_EQ(cal.get_calibration_count(), uint16{ 10 });
+  EXPECT_EQ(cal.get_scale(), recorder_calibration_type::kScaleMin);
+}
+
+// -----------------------------------------------------------------------
+/// @brief Valid packets per second with and without timing calibration on waveforms with a
+/// skewed clock
+// -----------------------------------------------------------------------
+TEST(Ut_TimingCalibration, packets_per_second)
+{
+  constexpr int kNrRefreshs = 4;
+  constexpr uint32 kNrPackets = static_cast<uint32>(kNrRefreshs * 256);
+  // [%] clock of the decoder relative to the command station
+  const uint16 skews[] = { 80U, 90U, 100U, 110U, 120U };
+
+  for (uint16 skew : skews)
+  {
+    encoder_type::config_type cfg = encoder_type::default_config();
+    cfg.one_us = static_cast<uint16>((58U * skew) / 100U);
+    cfg.zero_us = static_cast<uint16>((100U * skew) / 100U);
+    cfg.jitter_us = 2U;
+    cfg.cutout_us = 464U;
+    encoder_type enc(cfg);
+    const std::vector<uint16> deltas = make_waveform(enc, kNrRefreshs);
+    uint32 t = 0U;
+    for (uint16 dt : deltas)
+    {
+      t += dt;
+    }
+    // track time in the clock of the command station
+    t = (t * 100U) / skew;
+
+    PacketCounterClass handler1;
+    packet_extractor_type pe1(handler1);
+    bit_extractor_type be1(pe1);
+    be1.execute_many(deltas.data(), deltas.size());
+
+    PacketCounterClass handler2;
+    packet_extractor_type pe2(handler2);
+    bit_extractor_type be2(pe2);
+    calibration_type cal(be2);
+    cal.execute_many(deltas.data(), deltas.size());
+
+    // the calibration locks within the first packets
+    EXPECT_EQ(handler2.nr_checksum_ok + 4U >= kNrPackets, true);
+    if ((skew == 80U) || (skew == 120U))
+    {
+      EXPECT_EQ(handler1.nr_checksum_ok, uint32{ 0 });
+    }
+
+    const uint32 pps1 = static_cast<uint32>((static_cast<unsigned long long>(handler1.nr_checksum_ok) * 1000000ULL) / t);
+    const uint32 pps2 = static_cast<uint32>((static_cast<unsigned long long>(handler2.nr_checksum_ok) * 1000000ULL) / t);
+    hal::serial::print("clock ");
+    hal::serial::print(static_cast<uint32>(skew));
+    hal::serial::print("%: ");
+    hal::serial::print(pps1);
+    hal::serial::print(" valid packets/s without, ");
+    hal::serial::print(pps2);
+    hal::serial::print(" with timing calibration (scale ");
+    hal::serial::print(static_cast<uint32>(cal.get_scale()));
+    hal::serial::println("/256)");
+  }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(nominal);
+  RUN_TEST(skew);
+  RUN_TEST(reject);
+  RUN_TEST(packets_per_second);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
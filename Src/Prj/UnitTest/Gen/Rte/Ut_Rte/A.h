@@ -6,17 +6,31 @@
 #define SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_A_H_
 
 #include <Std_Types.h>
+#include <Hal/Timer.h>
+
+/// Counts the calls of runables so that tests can check the order of the calls
+inline uint32& call_sequence()
+{
+  static uint32 seq = 0;
+  return seq;
+}
 
 class A
 {
 public:
   uint32 ulCallsCyc;
   uint32 ulCallsInit;
-  A() : ulCallsCyc{ 0 }, ulCallsInit{ 0 }
+  uint32 ulCallsEvent;
+  uint32 ulSeqCyc;
+  uint32 ulSeqEvent;
+  /// [us] The cyclic runable advances the stubbed time by this value
+  uint32 ulRunTime;
+  A() : ulCallsCyc{ 0 }, ulCallsInit{ 0 }, ulCallsEvent{ 0 }, ulSeqCyc{ 0 }, ulSeqEvent{ 0 }, ulRunTime{ 0 }
   {}
   virtual ~A() {}
   void init(void) { ulCallsInit++; }
-  void func(void) { ulCallsCyc++; }
+  void func(void) { ulCallsCyc++; ulSeqCyc = ++call_sequence(); hal::stubs::micros += ulRunTime; }
+  void evnt(void) { ulCallsEvent++; ulSeqEvent = ++call_sequence(); }
 };
 
 #endif  // SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_A_H_
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_B_H_
 
 #include <Std_Types.h>
+#include <A.h>
 
 /// Another class with a runable function
 class B
@@ -13,10 +14,11 @@ class B
 public:
   uint32 ulCallsCyc;
   uint32 ulCallsEvent;
-  B() : ulCallsCyc{ 0 }, ulCallsEvent{ 0 } {}
+  uint32 ulSeqEvent;
+  B() : ulCallsCyc{ 0 }, ulCallsEvent{ 0 }, ulSeqEvent{ 0 } {}
   virtual ~B() {}
   void func(void) { ulCallsCyc++; }
-  void evnt(void) { ulCallsEvent++; }
+  void evnt(void) { ulCallsEvent++; ulSeqEvent = ++call_sequence(); }
 };
 
 #endif  // SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_B_H_
\ No newline at end of file
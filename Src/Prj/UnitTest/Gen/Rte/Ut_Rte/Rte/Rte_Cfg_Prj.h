@@ -15,6 +15,21 @@
 #include <A.h>
 #include <B.h>
 
+// This macro is used to configure the RTE to dispatch event runables
+#ifndef RTE_CFG_EVENT_AVAILABLE
+#define RTE_CFG_EVENT_AVAILABLE
+#endif
+
+// This macro is used to configure the RTE to add features for RTE monitoring
+#ifndef RTE_CFG_PORT_SR_AVAILABLE
+#define RTE_CFG_PORT_SR_AVAILABLE
+#endif
+
+// This macro is used to configure the RTE to measure run time, release jitter and overruns of runables
+#ifndef RTE_CFG_PROFILING_AVAILABLE
+#define RTE_CFG_PROFILING_AVAILABLE
+#endif
+
 RTE_DEF_START
 
 RTE_DEF_OBJ_START
@@ -31,8 +46,14 @@ RTE_DEF_CYCLIC_RUNABLE(A, a1, func,    0, 10000)
 RTE_DEF_CYCLIC_RUNABLE(B, b1, func, 1000, 20000)
 RTE_DEF_CYCLIC_RUNABLE_END
 
+RTE_DEF_EVENT_RUNABLE_START
+RTE_DEF_EVENT_RUNABLE(a1_evnt, A, a1, evnt)
+RTE_DEF_EVENT_RUNABLE(b1_evnt, B, b1, evnt)
+RTE_DEF_EVENT_RUNABLE_END
+
 RTE_DEF_PORT_SR_START
 RTE_DEF_PORT_SR(rte::Ifc_Uint16, ifc_uint16)
+RTE_DEF_PORT_SR_CONTAINER(rte::Ifc_Uint16Array, ifc_uint16_array)
 RTE_DEF_PORT_SR_END
 
 RTE_DEF_END
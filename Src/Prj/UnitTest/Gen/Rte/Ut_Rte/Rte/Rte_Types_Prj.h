@@ -12,12 +12,16 @@
 #define RTE_TYPE_PRJ_H_
 
 #include <Std_Types.h>
+#include <Util/Array.h>
 #include <Rte/Rte.h>
 
 namespace rte
 {
     /// SR interface
     using Ifc_Uint16 = rte::ifc_sr<uint16>;
+    /// SR interface for arrays
+    using uint16_array = util::array<uint16, 4>;
+    using Ifc_Uint16Array = rte::ifc_sr_array<uint16_array>;
 } // namespace rte
 
 #endif // RTE_TYPE_PRJ_H_
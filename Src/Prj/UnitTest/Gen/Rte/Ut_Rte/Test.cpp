@@ -12,6 +12,7 @@
 
 #include <unity_adapt.h>
 #include <Hal/Timer.h>
+#include <Hal/Serial.h>
 #include <Rte/Rte.h>
 
 /**
@@ -59,6 +60,189 @@ TEST(Ut_Rte, init_and_run_1)
   EXPECT_EQ(rte::b1.ulCallsCyc, static_cast<uint32>(2));
 }
 
+// --------------------------------------------------------------------------------------------
+/// Test case for event runables
+/// - an event runable is called once per setEvent()
+/// - pending events are dispatched in the order of their definition, before the cyclic runables
+/// - invalid event ids are ignored, start() clears pending events
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, event_1)
+{
+  hal::stubs::micros = 0U;
+  rte::start();
+  rte::a1.ulCallsEvent = 0U;
+  rte::b1.ulCallsEvent = 0U;
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(0));
+  EXPECT_EQ(rte::b1.ulCallsEvent, static_cast<uint32>(0));
+
+  // lower priority first, both run in priority order before the cyclic runable of a1
+  hal::stubs::micros = 10000U;
+  rte::setEvent(rte::kEvent_b1_evnt);
+  rte::setEvent(rte::kEvent_a1_evnt);
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(1));
+  EXPECT_EQ(rte::b1.ulCallsEvent, static_cast<uint32>(1));
+  EXPECT_EQ(rte::a1.ulSeqEvent < rte::b1.ulSeqEvent, true);
+  EXPECT_EQ(rte::b1.ulSeqEvent < rte::a1.ulSeqCyc, true);
+
+  // an event is dispatched once, also if it is set multiple times
+  rte::setEvent(rte::kEvent_b1_evnt);
+  rte::setEvent(rte::kEvent_b1_evnt);
+  rte::exec();
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(1));
+  EXPECT_EQ(rte::b1.ulCallsEvent, static_cast<uint32>(2));
+
+  // invalid event ids are ignored
+  rte::setEvent(rte::kEvent_Max);
+  rte::setEvent(rte::kInvalidEventId);
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(1));
+  EXPECT_EQ(rte::b1.ulCallsEvent, static_cast<uint32>(2));
+
+  // start() clears pending events
+  rte::setEvent(rte::kEvent_a1_evnt);
+  rte::start();
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(1));
+}
+
+/// Reads of micros() per run of a cyclic runable for profiling (see RTE_CFG_PROFILING_AVAILABLE)
+constexpr uint32 kProfilingReads = 2U;
+
+/// Idle hook for test case next_release_1
+static uint32 ulIdleCalls;
+static uint32 ulIdleTime;
+static void idle_hook(uint32 ulTimeToNextRelease)
+{
+  ulIdleCalls++;
+  ulIdleTime = ulTimeToNextRelease;
+}
+
+// --------------------------------------------------------------------------------------------
+/// Test case for the next release time and the idle hook
+/// - exec() reads the time once and doesn't scan the runables before the next release time
+/// - the idle hook is called if no runable is due and no event is pending
+/// - measures the reads of micros() and the idle ratio of a loop with 100 us per iteration
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, next_release_1)
+{
+  hal::stubs::micros = 0U;
+  rte::start();
+  rte::setIdleHook(&idle_hook);
+  ulIdleCalls = 0U;
+  const uint32 ulCallsA = rte::a1.ulCallsCyc;
+  const uint32 ulCallsB = rte::b1.ulCallsCyc;
+  uint32 ulReads = hal::stubs::micros_reads;
+  rte::exec();
+  EXPECT_EQ(hal::stubs::micros_reads - ulReads, static_cast<uint32>(1) + kProfilingReads);
+  EXPECT_EQ(rte::a1.ulCallsCyc - ulCallsA, static_cast<uint32>(1));
+  EXPECT_EQ(ulIdleCalls, static_cast<uint32>(0));
+
+  // b1 is due at 1000 us
+  hal::stubs::micros = 400U;
+  ulReads = hal::stubs::micros_reads;
+  rte::exec();
+  EXPECT_EQ(hal::stubs::micros_reads - ulReads, static_cast<uint32>(1));
+  EXPECT_EQ(ulIdleCalls, static_cast<uint32>(1));
+  EXPECT_EQ(ulIdleTime, static_cast<uint32>(600));
+
+  // no idle hook while an event is pending
+  rte::setEvent(rte::kEvent_a1_evnt);
+  rte::setEvent(rte::kEvent_a1_evnt);
+  rte::a1.ulCallsEvent = 0U;
+  hal::stubs::micros = 999U;
+  rte::exec();
+  EXPECT_EQ(rte::a1.ulCallsEvent, static_cast<uint32>(1));
+  EXPECT_EQ(ulIdleCalls, static_cast<uint32>(2));
+  hal::stubs::micros = 1000U;
+  rte::exec();
+  EXPECT_EQ(rte::b1.ulCallsCyc - ulCallsB, static_cast<uint32>(1));
+  EXPECT_EQ(ulIdleCalls, static_cast<uint32>(2));
+
+  // loop for one second with 100 us per iteration
+  constexpr uint32 kLoops = 10000U;
+  // number of cyclic runables in Rte_Cfg_Prj.h
+  constexpr uint32 kNrCyclicRunables = 2U;
+  ulIdleCalls = 0U;
+  ulReads = hal::stubs::micros_reads;
+  for (uint32 i = 0U; i < kLoops; i++)
+  {
+    hal::stubs::micros += 100U;
+    rte::exec();
+  }
+  const uint32 ulNrReads = hal::stubs::micros_reads - ulReads - 150U * kProfilingReads;
+  EXPECT_EQ(rte::a1.ulCallsCyc - ulCallsA, static_cast<uint32>(101));
+  EXPECT_EQ(rte::b1.ulCallsCyc - ulCallsB, static_cast<uint32>(51));
+  EXPECT_EQ(ulNrReads, kLoops);
+  // each loop is idle except the loops that run a1 (100x) or b1 (50x)
+  EXPECT_EQ(ulIdleCalls, kLoops - 150U);
+  hal::serial::print("exec: ");
+  hal::serial::print(ulNrReads);
+  hal::serial::print(" reads of micros() (scan all runables: ");
+  hal::serial::print(kLoops * kNrCyclicRunables);
+  hal::serial::print("), ");
+  hal::serial::print((ulIdleCalls * 100U) / kLoops);
+  hal::serial::println("% idle loops");
+
+  rte::setIdleHook(nullptr);
+}
+
+// --------------------------------------------------------------------------------------------
+/// Test case for profiling
+/// - run time, release jitter and overruns of init and cyclic runables on port rte_profiling
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, profiling_1)
+{
+  // index of the runables on port rte_profiling: init a1, cyclic a1, cyclic b1
+  constexpr size_t kInitA = 0U * rte::kProfiling_NrValues;
+  constexpr size_t kCycA = 1U * rte::kProfiling_NrValues;
+  constexpr size_t kCycB = 2U * rte::kProfiling_NrValues;
+
+  const rte::port_data_t * pPort = rte::getPortData("rte_profiling");
+  EXPECT_EQ(pPort != nullptr, true);
+  EXPECT_EQ(pPort->size, static_cast<size_t>(3U * rte::kProfiling_NrValues));
+  EXPECT_EQ(pPort->size_of_element, sizeof(uint32));
+  const uint32 * pValues = static_cast<const uint32 *>(pPort->pData);
+
+  hal::stubs::micros = 0U;
+  rte::start();
+  EXPECT_EQ(pValues[kInitA + rte::kProfiling_Count], static_cast<uint32>(1));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_Count], static_cast<uint32>(0));
+
+  // a1 released at 0 us, runs 300 us
+  rte::a1.ulRunTime = 300U;
+  rte::exec();
+  // b1 released at 1000 us, starts 50 us late
+  hal::stubs::micros = 1050U;
+  rte::exec();
+  // a1 released at 10000 us, starts 20 us late, runs 12000 us and ends after its next release
+  rte::a1.ulRunTime = 12000U;
+  hal::stubs::micros = 10020U;
+  rte::exec();
+  rte::a1.ulRunTime = 0U;
+
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_Count], static_cast<uint32>(2));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_RunTimeMin], static_cast<uint32>(300));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_RunTimeMax], static_cast<uint32>(12000));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_RunTimeSum], static_cast<uint32>(12300));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_RunTimeSum] / pValues[kCycA + rte::kProfiling_Count], static_cast<uint32>(6150));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_JitterMin], static_cast<uint32>(0));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_JitterMax], static_cast<uint32>(20));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_JitterSum], static_cast<uint32>(20));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_Overruns], static_cast<uint32>(1));
+  EXPECT_EQ(pValues[kCycB + rte::kProfiling_Count], static_cast<uint32>(1));
+  EXPECT_EQ(pValues[kCycB + rte::kProfiling_RunTimeMax], static_cast<uint32>(0));
+  EXPECT_EQ(pValues[kCycB + rte::kProfiling_JitterMax], static_cast<uint32>(50));
+  EXPECT_EQ(pValues[kCycB + rte::kProfiling_Overruns], static_cast<uint32>(0));
+
+  // start() clears the profiling data
+  rte::start();
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_Count], static_cast<uint32>(0));
+  EXPECT_EQ(pValues[kCycA + rte::kProfiling_Overruns], static_cast<uint32>(0));
+}
+
 // --------------------------------------------------------------------------------------------
 /// Test case for SR interface
 /// - write to a SR port
@@ -78,6 +262,106 @@ TEST(Ut_Rte, interface_sr_1)
   EXPECT_EQ(val, static_cast<uint16_t>(1000U));
 }
 
+// --------------------------------------------------------------------------------------------
+/// Test case for versions and views of SR interfaces
+/// - each write changes the version, update() changes it only if the array changes
+/// - a view refers to the data of the port without a copy
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, interface_sr_version_1)
+{
+  rte::version_type ver;
+  uint16 val;
+
+  ver = rte::ifc_uint16::getVersion();
+  EXPECT_EQ(rte::ifc_uint16::write(7U), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16::getVersion(), static_cast<rte::version_type>(ver + 2U));
+  EXPECT_EQ(rte::ifc_uint16::view().size(), static_cast<size_t>(1));
+  EXPECT_EQ(rte::ifc_uint16::view()[0], static_cast<uint16>(7U));
+  EXPECT_EQ(rte::ifc_uint16::readSnapshot(val), rte::ifc_base::OK);
+  EXPECT_EQ(val, static_cast<uint16>(7U));
+
+  rte::uint16_array arr{ { 1U, 2U, 3U, 4U } };
+  rte::uint16_array arr_read{ { 0U, 0U, 0U, 0U } };
+  ver = rte::ifc_uint16_array::getVersion();
+  EXPECT_EQ(rte::ifc_uint16_array::write(arr), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 2U));
+  EXPECT_EQ(rte::ifc_uint16_array::update(arr), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 2U));
+  arr[3] = 40U;
+  EXPECT_EQ(rte::ifc_uint16_array::update(arr), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 4U));
+  EXPECT_EQ(rte::ifc_uint16_array::writeElement(0U, 10U), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 6U));
+
+  const rte::Ifc_Uint16Array::view_type v = rte::ifc_uint16_array::view();
+  EXPECT_EQ(v.data() == rte::ifc_uint16_array::obj.data(), true);
+  EXPECT_EQ(v.size(), static_cast<size_t>(4));
+  EXPECT_EQ(v[0], static_cast<uint16>(10U));
+  EXPECT_EQ(v[3], static_cast<uint16>(40U));
+  EXPECT_EQ(rte::ifc_uint16_array::readSnapshot(arr_read), rte::ifc_base::OK);
+  EXPECT_EQ(arr_read[0], static_cast<uint16>(10U));
+  EXPECT_EQ(arr_read[1], static_cast<uint16>(2U));
+  EXPECT_EQ(arr_read[3], static_cast<uint16>(40U));
+}
+
+// --------------------------------------------------------------------------------------------
+/// Test case for writes of several elements of an SR interface
+/// - the version is odd between beginWrite() and endWrite() and changes once for all elements
+/// - nested writes do not end the write
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, interface_sr_version_2)
+{
+  rte::version_type ver;
+
+  ver = rte::ifc_uint16_array::getVersion();
+  EXPECT_EQ((ver & 1U) == 0U, true);
+  rte::ifc_uint16_array::beginWrite();
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 1U));
+  EXPECT_EQ(rte::ifc_uint16_array::writeElement(0U, 100U), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::writeElement(1U, 200U), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 1U));
+  rte::ifc_uint16_array::beginWrite();
+  EXPECT_EQ(rte::ifc_uint16_array::writeElement(2U, 300U), rte::ifc_base::OK);
+  rte::ifc_uint16_array::endWrite();
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 1U));
+  rte::ifc_uint16_array::endWrite();
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 2U));
+
+  // a single element is a write of its own
+  EXPECT_EQ(rte::ifc_uint16_array::writeElement(3U, 400U), rte::ifc_base::OK);
+  EXPECT_EQ(rte::ifc_uint16_array::getVersion(), static_cast<rte::version_type>(ver + 4U));
+
+  rte::uint16_array arr_read{ { 0U, 0U, 0U, 0U } };
+  EXPECT_EQ(rte::ifc_uint16_array::readSnapshot(arr_read), rte::ifc_base::OK);
+  EXPECT_EQ(arr_read[0], static_cast<uint16>(100U));
+  EXPECT_EQ(arr_read[2], static_cast<uint16>(300U));
+  EXPECT_EQ(arr_read[3], static_cast<uint16>(400U));
+}
+
+// --------------------------------------------------------------------------------------------
+/// Test case for port names
+/// - each port is found by its name
+/// - unknown names and prefixes of names are not found
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte, port_name_1)
+{
+  char name[rte::kMaxLenPortName + 1U];
+
+  EXPECT_EQ(rte::getNrPorts(), static_cast<size_t>(3));
+  for (size_t idx = 0U; idx < rte::getNrPorts(); idx++)
+  {
+    rte::port_data_t * pPort = rte::getPortData(idx);
+    ROM_READ_STRING(name, pPort->szName);
+    EXPECT_EQ(rte::getPortData(name) == pPort, true);
+  }
+  EXPECT_EQ(rte::getPortData("ifc_uint16") == rte::getPortData(static_cast<size_t>(1)), true);
+  EXPECT_EQ(rte::getPortData("ifc_uint1") == nullptr, true);
+  EXPECT_EQ(rte::getPortData("ifc_uint160") == nullptr, true);
+  EXPECT_EQ(rte::getPortData("a") == nullptr, true);
+  EXPECT_EQ(rte::getPortData("z") == nullptr, true);
+  EXPECT_EQ(rte::getPortData("") == nullptr, true);
+}
+
 /** 
  * @brief Intended to be called before each test.
  */
@@ -109,7 +393,13 @@ bool test_loop(void)
   UNITY_BEGIN();
 
   RUN_TEST(init_and_run_1);
+  RUN_TEST(event_1);
+  RUN_TEST(next_release_1);
+  RUN_TEST(profiling_1);
   RUN_TEST(interface_sr_1);
+  RUN_TEST(interface_sr_version_1);
+  RUN_TEST(interface_sr_version_2);
+  RUN_TEST(port_name_1);
 
   (void) UNITY_END();
 
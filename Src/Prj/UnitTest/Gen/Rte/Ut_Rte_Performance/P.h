@@ -0,0 +1,20 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_PERFORMANCE_P_H_
+#define SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_PERFORMANCE_P_H_
+
+#include <Std_Types.h>
+
+/// A class with runable functions (the RTE needs at least one init and one cyclic runable)
+class P
+{
+public:
+  uint32 ulCalls;
+  P() : ulCalls{ 0 } {}
+  void init(void) { ulCalls = 0; }
+  void func(void) { ulCalls++; }
+};
+
+#endif  // SRC_PRJ_UNITTEST_GEN_RTE_UT_RTE_PERFORMANCE_P_H_
@@ -0,0 +1,69 @@
+/**
+ * @file Rte_Cfg_Prj.h
+ * 
+ * @author Ralf Sondershaus
+ *
+ * @brief RTE declaration for RTE performance test with 300 SR ports.
+ *
+ * This file doesn't have include guards because it is included several times in a row.
+ *
+ * @copyright Copyright 2026 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <P.h>
+
+// This macro is used to configure the RTE to add features for RTE monitoring
+#ifndef RTE_CFG_PORT_SR_AVAILABLE
+#define RTE_CFG_PORT_SR_AVAILABLE
+#endif
+
+// Define 10, 100 ports with names prefix + digits. The digits are not in ascending
+// order, so the order of definition differs from the order of the names.
+#ifndef UT_RTE_PERFORMANCE_PORTS_10
+#define UT_RTE_PERFORMANCE_PORTS_10(prefix) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##7) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##2) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##9) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##0) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##5) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##3) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##8) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##1) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##6) \
+  RTE_DEF_PORT_SR(rte::Ifc_Uint16, prefix##4)
+#define UT_RTE_PERFORMANCE_PORTS_100(prefix) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##4) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##8) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##1) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##6) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##0) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##9) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##3) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##7) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##2) \
+  UT_RTE_PERFORMANCE_PORTS_10(prefix##5)
+#endif
+
+RTE_DEF_START
+
+RTE_DEF_OBJ_START
+RTE_DEF_OBJ(P, p1)
+RTE_DEF_OBJ_END
+
+RTE_DEF_INIT_RUNABLE_START
+RTE_DEF_INIT_RUNABLE(P, p1, init)
+RTE_DEF_INIT_RUNABLE_END
+
+RTE_DEF_CYCLIC_RUNABLE_START
+RTE_DEF_CYCLIC_RUNABLE(P, p1, func, 0, 10000)
+RTE_DEF_CYCLIC_RUNABLE_END
+
+RTE_DEF_PORT_SR_START
+UT_RTE_PERFORMANCE_PORTS_100(ifc_port_2)
+UT_RTE_PERFORMANCE_PORTS_100(ifc_port_0)
+UT_RTE_PERFORMANCE_PORTS_100(ifc_port_1)
+RTE_DEF_PORT_SR_END
+
+RTE_DEF_END
@@ -0,0 +1,122 @@
+/**
+ * @file Ut_Rte_Performance/Test.cpp
+ *
+ * @brief Unit tests to measure run time of rte::getPortData(const char *) with 300 ports
+ *
+ * @copyright Copyright 2026 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Hal/Serial.h>
+#include <Hal/Timer.h>
+#include <unity_adapt.h>
+#include <Util/String_view.h>
+#include <Rte/Rte.h>
+
+/// Number of ports in Rte_Cfg_Prj.h
+static constexpr size_t kNrPorts = 300U;
+
+/// Names of all ports (copied from ROM)
+static char aNames[kNrPorts][rte::kMaxLenPortName + 1U];
+
+/// Linear search of the previous implementation, for reference (names are in RAM on the host)
+static rte::port_data_t * getPortDataLinear(const char * portName)
+{
+  for (size_t idx = 0U; idx < rte::getNrPorts(); idx++)
+  {
+    rte::port_data_t * pPort = rte::getPortData(idx);
+    if (util::string_view{pPort->szName}.compare(portName) == 0)
+    {
+      return pPort;
+    }
+  }
+  return nullptr;
+}
+
+// --------------------------------------------------------------------------------------------
+/// Each port is found by its name
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte_Performance, getPortData_all)
+{
+  EXPECT_EQ(rte::getNrPorts(), kNrPorts);
+  for (size_t idx = 0U; idx < rte::getNrPorts(); idx++)
+  {
+    ROM_READ_STRING(aNames[idx], rte::getPortData(idx)->szName);
+  }
+  for (size_t idx = 0U; idx < rte::getNrPorts(); idx++)
+  {
+    EXPECT_EQ(rte::getPortData(aNames[idx]) == rte::getPortData(idx), true);
+    EXPECT_EQ(getPortDataLinear(aNames[idx]) == rte::getPortData(idx), true);
+  }
+  EXPECT_EQ(rte::getPortData("ifc_port_300") == nullptr, true);
+  EXPECT_EQ(rte::getPortData("ifc_port_") == nullptr, true);
+}
+
+// --------------------------------------------------------------------------------------------
+/// Run time of the lookup of all port names: binary search vs. linear search
+// --------------------------------------------------------------------------------------------
+TEST(Ut_Rte_Performance, getPortData_run_time)
+{
+  constexpr int nr_rep = 100; /**< Number of repetitions for performance testing */
+  uint32 t1;
+  uint32 td_binary;
+  uint32 td_linear;
+  size_t nr_found = 0U;
+
+  t1 = hal::micros();
+  for (int i = 0; i < nr_rep; i++)
+  {
+    for (size_t idx = 0U; idx < kNrPorts; idx++)
+    {
+      nr_found += (rte::getPortData(aNames[idx]) != nullptr) ? 1U : 0U;
+    }
+  }
+  td_binary = hal::micros() - t1;
+
+  t1 = hal::micros();
+  for (int i = 0; i < nr_rep; i++)
+  {
+    for (size_t idx = 0U; idx < kNrPorts; idx++)
+    {
+      nr_found += (getPortDataLinear(aNames[idx]) != nullptr) ? 1U : 0U;
+    }
+  }
+  td_linear = hal::micros() - t1;
+
+  EXPECT_EQ(nr_found, static_cast<size_t>(2 * nr_rep * kNrPorts));
+
+  hal::serial::print("getPortData(name) with ");
+  hal::serial::print(static_cast<uint32>(kNrPorts));
+  hal::serial::print(" ports: sorted ");
+  hal::serial::print((td_binary * 1000U) / (nr_rep * kNrPorts));
+  hal::serial::print(" ns, linear ");
+  hal::serial::print((td_linear * 1000U) / (nr_rep * kNrPorts));
+  hal::serial::println(" ns per lookup");
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+  rte::start();
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(getPortData_all);
+  RUN_TEST(getPortData_run_time);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
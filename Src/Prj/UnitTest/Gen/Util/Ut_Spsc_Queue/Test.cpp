@@ -0,0 +1,271 @@
+/**
+  * @file Test.cpp
+  *
+  * @author Ralf Sondershaus
+  *
+  * @brief Test for Gen/Util/Spsc_Queue.h
+  *
+  * @copyright Copyright 2025 Ralf Sondershaus
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  */
+
+#include <Util/Spsc_Queue.h>
+#include <unity_adapt.h>
+
+/// Construtor with 8 slots (7 elements)
+TEST(Ut_Spsc_Queue, construct_1)
+{
+  using queue_type = util::spsc_queue<uint16, 8>;
+  queue_type myqueue;
+
+  EXPECT_EQ(myqueue.size(), queue_type::size_type{ 0 });
+  EXPECT_EQ(myqueue.empty(), true);
+  EXPECT_EQ(myqueue.full(), false);
+  EXPECT_EQ(queue_type::max_size(), queue_type::size_type{ 7 });
+}
+
+/// Push until full, push once more (dropped), then pop all elements
+///
+/// push with       { 1, 2, 3, 4, 5, 6, 7, 8 }
+/// expected result { 1, 2, 3, 4, 5, 6, 7 }
+TEST(Ut_Spsc_Queue, push_pop_1)
+{
+  using queue_type = util::spsc_queue<uint16, 8>;
+  queue_type myqueue;
+  uint16 i;
+
+  for (i = 1; i <= 7; i++)
+  {
+    EXPECT_EQ(myqueue.push(i), true);
+    EXPECT_EQ(myqueue.size(), static_cast<queue_type::size_type>(i));
+    EXPECT_EQ(myqueue.front(), uint16{ 1 });
+  }
+  EXPECT_EQ(myqueue.full(), true);
+  EXPECT_EQ(myqueue.push(uint16{ 8 }), false);
+  EXPECT_EQ(myqueue.size(), queue_type::size_type{ 7 });
+
+  for (i = 1; i <= 7; i++)
+  {
+    EXPECT_EQ(myqueue.front(), i);
+    myqueue.pop();
+    EXPECT_EQ(myqueue.size(), static_cast<queue_type::size_type>(7 - i));
+  }
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+/// Indices wrap around several times
+TEST(Ut_Spsc_Queue, Wraparound)
+{
+  using queue_type = util::spsc_queue<uint16, 4>;
+  queue_type myqueue;
+  uint16 val;
+  uint16 expected = 0;
+
+  for (uint16 i = 0; i < 100; i++)
+  {
+    EXPECT_EQ(myqueue.push(i), true);
+    if (myqueue.size() == queue_type::max_size())
+    {
+      EXPECT_EQ(myqueue.pop(val), true);
+      EXPECT_EQ(val, expected);
+      expected++;
+    }
+  }
+  while (myqueue.pop(val))
+  {
+    EXPECT_EQ(val, expected);
+    expected++;
+  }
+  EXPECT_EQ(expected, uint16{ 100 });
+  EXPECT_EQ(myqueue.pop(val), false);
+}
+
+/// Maximal number of slots: 256 (255 elements) with single byte indices
+TEST(Ut_Spsc_Queue, Size256)
+{
+  using queue_type = util::spsc_queue<uint16, 256>;
+  queue_type myqueue;
+  uint16 val;
+
+  for (uint16 i = 0; i < 255; i++)
+  {
+    EXPECT_EQ(myqueue.push(i), true);
+  }
+  EXPECT_EQ(myqueue.size(), queue_type::size_type{ 255 });
+  EXPECT_EQ(myqueue.push(uint16{ 255 }), false);
+  for (uint16 i = 0; i < 255; i++)
+  {
+    EXPECT_EQ(myqueue.pop(val), true);
+    EXPECT_EQ(val, i);
+  }
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+/// High watermark and drop counter with the default policy (drop newest)
+TEST(Ut_Spsc_Queue, High_watermark_drop_newest)
+{
+  using queue_type = util::spsc_queue<uint16, 4>;
+  queue_type myqueue;
+  uint16 val;
+
+  EXPECT_EQ(myqueue.get_high_watermark(), queue_type::size_type{ 0 });
+  EXPECT_EQ(myqueue.push(uint16{ 1 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 2 }), true);
+  EXPECT_EQ(myqueue.get_high_watermark(), queue_type::size_type{ 2 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(myqueue.push(uint16{ 3 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 4 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 5 }), false);
+  EXPECT_EQ(myqueue.get_high_watermark(), queue_type::size_type{ 3 });
+  EXPECT_EQ(myqueue.get_drop_count(), uint16{ 1 });
+
+  // the new element was dropped
+  for (uint16 i = 2; i <= 4; i++)
+  {
+    EXPECT_EQ(myqueue.pop(val), true);
+    EXPECT_EQ(val, i);
+  }
+  EXPECT_EQ(myqueue.empty(), true);
+  EXPECT_EQ(myqueue.get_high_watermark(), queue_type::size_type{ 3 });
+}
+
+/// Drop oldest: a full queue keeps the newest elements
+///
+/// push with       { 0, 1, ..., 99 }
+/// expected result { 93, 94, ..., 99 }
+TEST(Ut_Spsc_Queue, Drop_oldest)
+{
+  using queue_type = util::spsc_queue<uint16, 8, util::SPSC_DROP_OLDEST>;
+  queue_type myqueue;
+  uint16 val;
+  uint16 expected = 93;
+
+  for (uint16 i = 0; i < 100; i++)
+  {
+    EXPECT_EQ(myqueue.push(i), i < 7);
+    EXPECT_EQ(myqueue.size(), static_cast<queue_type::size_type>((i < 7) ? (i + 1) : 7));
+  }
+  EXPECT_EQ(myqueue.full(), true);
+  EXPECT_EQ(myqueue.get_drop_count(), uint16{ 93 });
+  EXPECT_EQ(myqueue.get_high_watermark(), queue_type::size_type{ 7 });
+  while (myqueue.pop(val))
+  {
+    EXPECT_EQ(val, expected);
+    expected++;
+  }
+  EXPECT_EQ(expected, uint16{ 100 });
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+/// Drop oldest: the element that the consumer reads is not dropped
+TEST(Ut_Spsc_Queue, Drop_oldest_holding)
+{
+  using queue_type = util::spsc_queue<uint16, 4, util::SPSC_DROP_OLDEST>;
+  queue_type myqueue;
+  uint16 val;
+
+  EXPECT_EQ(myqueue.push(uint16{ 1 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 2 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 3 }), true);
+
+  // consumer reads the first element: the producer drops the new elements
+  const uint16& ref = myqueue.front();
+  EXPECT_EQ(myqueue.push(uint16{ 4 }), false);
+  EXPECT_EQ(myqueue.push(uint16{ 5 }), false);
+  EXPECT_EQ(ref, uint16{ 1 });
+  myqueue.pop();
+
+  // consumer released the element: the producer drops the oldest element again
+  EXPECT_EQ(myqueue.push(uint16{ 6 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 7 }), false);
+  EXPECT_EQ(myqueue.get_drop_count(), uint16{ 3 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 3 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 6 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 7 });
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+/// Drop oldest: after front() and release(), the producer drops the oldest element again
+TEST(Ut_Spsc_Queue, Drop_oldest_release)
+{
+  using queue_type = util::spsc_queue<uint16, 4, util::SPSC_DROP_OLDEST>;
+  queue_type myqueue;
+  uint16 val;
+
+  EXPECT_EQ(myqueue.push(uint16{ 1 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 2 }), true);
+  EXPECT_EQ(myqueue.push(uint16{ 3 }), true);
+
+  // consumer peeks at the first element and keeps it in the queue
+  EXPECT_EQ(myqueue.front(), uint16{ 1 });
+  myqueue.release();
+  EXPECT_EQ(myqueue.push(uint16{ 4 }), false);
+  EXPECT_EQ(myqueue.get_drop_count(), uint16{ 1 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 2 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 3 });
+  EXPECT_EQ(myqueue.pop(val), true);
+  EXPECT_EQ(val, uint16{ 4 });
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+/// Construct elements in place with back_slot() and commit()
+TEST(Ut_Spsc_Queue, Back_slot_commit)
+{
+  using queue_type = util::spsc_queue<uint16, 4>;
+  queue_type myqueue;
+  uint16 val;
+
+  for (uint16 i = 1; i <= 3; i++)
+  {
+    myqueue.back_slot() = i;
+    EXPECT_EQ(myqueue.commit(), true);
+  }
+  // full: the slot is still owned by the producer, commit drops it
+  myqueue.back_slot() = 4;
+  EXPECT_EQ(myqueue.commit(), false);
+  EXPECT_EQ(myqueue.get_drop_count(), uint16{ 1 });
+  for (uint16 i = 1; i <= 3; i++)
+  {
+    EXPECT_EQ(myqueue.pop(val), true);
+    EXPECT_EQ(val, i);
+  }
+  EXPECT_EQ(myqueue.empty(), true);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(construct_1);
+  RUN_TEST(push_pop_1);
+  RUN_TEST(Wraparound);
+  RUN_TEST(Size256);
+  RUN_TEST(High_watermark_drop_newest);
+  RUN_TEST(Drop_oldest);
+  RUN_TEST(Drop_oldest_holding);
+  RUN_TEST(Drop_oldest_release);
+  RUN_TEST(Back_slot_commit);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
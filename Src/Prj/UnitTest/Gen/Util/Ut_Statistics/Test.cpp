@@ -0,0 +1,105 @@
+/**
+ * @file Ut_Statistics/Test.cpp
+ *
+ * @brief Unit tests for class util::statistics of Gen/Util/Statistics.h
+ *
+ * @copyright Copyright 2025 Ralf Sondershaus
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unity_adapt.h>
+#include <Util/Statistics.h>
+#include <Util/Array.h>
+
+// -----------------------------------------------------------------------
+/// @brief Minimum, average, maximum and bins of a few samples
+// -----------------------------------------------------------------------
+TEST(Ut_Statistics, min_avg_max_bins)
+{
+  using stats_type = util::statistics<4, 1024U>;
+  stats_type stats;
+
+  EXPECT_EQ(stats.get_count(), uint32{ 0 });
+  EXPECT_EQ(stats.get_min(), uint32{ 0 });
+  EXPECT_EQ(stats.get_avg(), uint32{ 0 });
+  EXPECT_EQ(stats.get_max(), uint32{ 0 });
+
+  // bins: [0, 1024), [1024, 2048), [2048, 4096), [4096, ...)
+  stats.add(500U);
+  stats.add(1023U);
+  stats.add(1024U);
+  stats.add(4095U);
+  stats.add(100000U);
+
+  EXPECT_EQ(stats.get_count(), uint32{ 5 });
+  EXPECT_EQ(stats.get_min(), uint32{ 500 });
+  EXPECT_EQ(stats.get_avg(), uint32{ (500U + 1023U + 1024U + 4095U + 100000U) / 5U });
+  EXPECT_EQ(stats.get_max(), uint32{ 100000 });
+  EXPECT_EQ(stats.get_bin(0), uint32{ 2 });
+  EXPECT_EQ(stats.get_bin(1), uint32{ 1 });
+  EXPECT_EQ(stats.get_bin(2), uint32{ 1 });
+  EXPECT_EQ(stats.get_bin(3), uint32{ 1 });
+
+  util::array<uint32, stats_type::kNrValues> values;
+  stats.copy_to(values);
+  EXPECT_EQ(values[stats_type::kCount], uint32{ 5 });
+  EXPECT_EQ(values[stats_type::kMin], uint32{ 500 });
+  EXPECT_EQ(values[stats_type::kMax], uint32{ 100000 });
+  EXPECT_EQ(values[stats_type::kFirstBin + 3], uint32{ 1 });
+
+  stats.clear();
+  EXPECT_EQ(stats.get_count(), uint32{ 0 });
+  EXPECT_EQ(stats.get_min(), uint32{ 0 });
+  EXPECT_EQ(stats.get_bin(0), uint32{ 0 });
+}
+
+// -----------------------------------------------------------------------
+/// @brief The average follows the samples if the sum overflows
+// -----------------------------------------------------------------------
+TEST(Ut_Statistics, avg_overflow)
+{
+  util::statistics<> stats;
+
+  for (int i = 0; i < 100; i++)
+  {
+    stats.add(0x40000000U);
+  }
+  EXPECT_EQ(stats.get_count(), uint32{ 100 });
+  EXPECT_EQ(stats.get_avg(), uint32{ 0x40000000U });
+  EXPECT_EQ(stats.get_bin(7), uint32{ 100 });
+
+  for (int i = 0; i < 100; i++)
+  {
+    stats.add(1000U);
+  }
+  EXPECT_EQ(stats.get_count(), uint32{ 200 });
+  EXPECT_EQ(stats.get_min(), uint32{ 1000 });
+  EXPECT_EQ(stats.get_avg() < uint32{ 0x40000000U }, true);
+  EXPECT_EQ(stats.get_bin(0), uint32{ 100 });
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_setup(void)
+{
+}
+
+bool test_loop(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(min_avg_max_bins);
+  RUN_TEST(avg_overflow);
+
+  (void) UNITY_END();
+
+  // Return false to stop program execution (relevant on Windows)
+  return false;
+}
@@ -13,6 +13,7 @@
 #include <Cal/CalM.h>
 #include <Dcc/BitExtractor.h>
 #include <Dcc/Decoder.h>
+#include <Dcc/Encoder.h>
 #include <Hal/EEPROM.h>
 #include <Hal/Gpio.h>
 #include <Hal/Timer.h>
@@ -1182,6 +1183,114 @@ TEST(Ut_Signal, Signal7_DCC_Aspects_2_3)
     log.stop();
 }
 
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+/**
+ * @test DCC_Latency
+ * @brief Tests the latency measurement from DCC packet to output (CFG_DCC_DECODER_TIMESTAMP).
+ *
+ * Each DCC packet that changes the aspect of signal 0 adds one sample to rte::ifc_dcc_latency.
+ * Repeated packets do not add samples.
+ */
+TEST(Ut_Signal, DCC_Latency)
+{
+    using stats_type = rte::dcc_latency_statistics;
+    typedef struct
+    {
+        uint32 ms;        // [ms] current time
+        uint32 pkt_us;    // [us] time stamp of the packet
+        uint8 byte2;      // second byte of the packet
+        uint32 count;     // expected number of samples
+        uint32 max_us;    // expected max latency
+    } step_type;
+
+    constexpr int kSignalPos = 0;
+    const uint8 byte0 = 0b10000000 | static_cast<uint8>(kSignalPos + 1);
+    const step_type aSteps[] =
+        {
+            {10, 9500, 0b11110011, 1, 500},    // aspect 3
+            {20, 19000, 0b11110011, 1, 500},   // repetition
+            {30, 27000, 0b11110010, 2, 3000}}; // aspect 2
+    rte::dcc_latency_array values;
+
+    hal::stubs::millis = 0;
+    hal::stubs::micros = 0;
+    hal::init_gpio();
+    rte::start();
+    rte::ifc_cal_set_defaults();
+    rte::set_cv(cal::cv::kSignalIDBase + kSignalPos, kBuiltInSignalIDAusfahrsignal);
+    rte::set_cv(cal::cv::kSignalFirstOutputBase + kSignalPos, cal::constants::make_signal_first_output(cal::constants::kOnboard, 13));
+    rte::set_cv(cal::cv::kSignalInputBase + kSignalPos, cal::constants::make_signal_input(cal::constants::kDcc, 0));
+
+    for (const step_type &step : aSteps)
+    {
+        const uint8 bytes[] = { byte0, step.byte2, static_cast<uint8>(byte0 ^ step.byte2) };
+        dcc::decoder::packet_type packet(bytes, sizeof(bytes) / sizeof(bytes[0]));
+        packet.set_timestamp(step.pkt_us);
+        dcc::decoder::get_instance().packet_received(packet);
+        hal::stubs::millis = step.ms;
+        hal::stubs::micros = 1000U * hal::stubs::millis;
+        rte::exec();
+        rte::ifc_dcc_latency::read(values);
+        EXPECT_EQ(values[stats_type::kCount], step.count);
+        EXPECT_EQ(values[stats_type::kMin], uint32{ 500 });
+        EXPECT_EQ(values[stats_type::kMax], step.max_us);
+        EXPECT_EQ(values[stats_type::kFirstBin], uint32{ 1 });
+    }
+}
+#endif
+
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+/**
+ * @test DCC_SignalQuality
+ * @brief Tests the signal quality metrics (CFG_DCC_DECODER_HALFBIT_HISTOGRAM).
+ *
+ * Idle packets are received within the first second. After the measurement window of
+ * DccDecoder, the histogram and the metrics are written to the RTE.
+ */
+TEST(Ut_Signal, DCC_SignalQuality)
+{
+    using histogram_type = rte::dcc_halfbit_histogram_type;
+    constexpr uint16 kNrPackets = 100U;
+    const uint8 bytes[] = { 0xFF, 0x00, 0xFF };
+    const dcc::decoder::packet_type packet(bytes, sizeof(bytes) / sizeof(bytes[0]));
+    dcc::encoder<dcc::decoder::packet_type> enc;
+    rte::dcc_halfbit_histogram_array bins;
+    rte::dcc_signal_quality_array metrics;
+    histogram_type::counters_type counters;
+    uint32 nr_ones = 0U;
+
+    hal::stubs::millis = 0;
+    hal::stubs::micros = 0;
+    hal::init_gpio();
+    // the measurement window starts
+    rte::start();
+    rte::ifc_cal_set_defaults();
+    // drop the time deltas of previous tests
+    dcc::decoder::get_instance().get_halfbit_histogram().take(counters);
+
+    for (uint16 i = 0; i < kNrPackets; i++)
+    {
+        enc.encode(packet, [&nr_ones](uint16 dt)
+        {
+            dcc::decoder::get_instance().edge_received(dt);
+            nr_ones += (dt == 58U) ? 1U : 0U;
+        });
+    }
+    hal::stubs::millis = 1000;
+    hal::stubs::micros = 1000U * hal::stubs::millis;
+    rte::exec();
+
+    rte::ifc_dcc_halfbit_histogram::read(bins);
+    rte::ifc_dcc_signal_quality::read(metrics);
+    // 58 us is in bin 56 - 59 us
+    EXPECT_EQ(static_cast<uint32>(bins[5]), nr_ones);
+    EXPECT_EQ(metrics[histogram_type::kMeanShort], uint16{ 580 });
+    EXPECT_EQ(metrics[histogram_type::kMeanLong], uint16{ 1020 });
+    EXPECT_EQ(metrics[histogram_type::kOutOfSpec], uint16{ 0 });
+    EXPECT_EQ(metrics[histogram_type::kPacketsPerSecond], kNrPackets);
+}
+#endif
+
 /**
  * @brief Tests DCC signal aspects 2 and 3 transitions for a railway signal
  *
@@ -1860,6 +1969,12 @@ bool test_loop(void)
     RUN_TEST(Signal7_DCC_Aspects_2_3);
     RUN_TEST(Signal0_DCC_Aspects_0_1_UserDefinedSignal0);
     RUN_TEST(Signal2_ADC_Green_Red_StepSize_2_BuiltIn_3);
+#if CFG_DCC_DECODER_TIMESTAMP == OPT_DCC_DECODER_TIMESTAMP_ON
+    RUN_TEST(DCC_Latency);
+#endif
+#if CFG_DCC_DECODER_HALFBIT_HISTOGRAM == OPT_DCC_DECODER_HALFBIT_HISTOGRAM_ON
+    RUN_TEST(DCC_SignalQuality);
+#endif
 
     RUN_TEST(Rte_get_signal_id);
     RUN_TEST(Rte_sig_is_built_in);
@@ -177,6 +177,29 @@ TEST(Ut_Signal_Com, AsciiCom_process_ETO_SET_SIGNAL_INVALID_IDX)
   EXPECT_EQ(aspect.change_over_time_10ms, dim_time_builtin);
 }
 
+//-------------------------------------------------------------------------
+TEST(Ut_Signal_Com, CalM_stage_cv_commit)
+{
+  // CVs are staged in RAM and written to EEPROM by cycle100() in batches
+  EXPECT_EQ(rte::stage_cv(cal::cv::kSignalIDBase + 0, 2U), true);
+  EXPECT_EQ(rte::stage_cv(cal::cv::kSignalIDBase + 1, 3U), true);
+  EXPECT_EQ(rte::stage_cv(cal::cv::kSignalIDBase + 2, 4U), true);
+  EXPECT_EQ(rte::get_cv(cal::cv::kSignalIDBase + 1), static_cast<uint8>(3));
+  EXPECT_EQ(rte::calm.is_commit_pending(), true);
+  EXPECT_EQ(hal::eeprom::stubs::elements[cal::eeprom::kSignalIDBase + 2] != static_cast<uint8>(4), true);
+
+  // deferred while CVs are staged
+  rte::calm.cycle100();
+  EXPECT_EQ(hal::eeprom::stubs::elements[cal::eeprom::kSignalIDBase + 0] != static_cast<uint8>(2), true);
+  rte::calm.cycle100();
+  EXPECT_EQ(hal::eeprom::stubs::elements[cal::eeprom::kSignalIDBase + 0], static_cast<uint8>(2));
+  EXPECT_EQ(hal::eeprom::stubs::elements[cal::eeprom::kSignalIDBase + 1], static_cast<uint8>(3));
+  EXPECT_EQ(rte::calm.is_commit_pending(), true);
+  rte::calm.cycle100();
+  EXPECT_EQ(hal::eeprom::stubs::elements[cal::eeprom::kSignalIDBase + 2], static_cast<uint8>(4));
+  EXPECT_EQ(rte::calm.is_commit_pending(), false);
+}
+
 //-------------------------------------------------------------------------
 TEST(Ut_Signal_Com, AsciiCom_process_INIT)
 {
@@ -218,6 +241,7 @@ bool test_loop(void)
   RUN_TEST(AsciiCom_process_ETO_SET_SIGNAL);
   RUN_TEST(AsciiCom_process_ETO_SET_SIGNAL_OPTIONAL_DIM_TIME);
   RUN_TEST(AsciiCom_process_ETO_SET_SIGNAL_INVALID_IDX);
+  RUN_TEST(CalM_stage_cv_commit);
   RUN_TEST(AsciiCom_process_INIT);
 
   UNITY_END();
@@ -238,11 +238,6 @@ TEST(Ut_Signal, LedRouter_AllRamps)
     hal::serial::println(td / nrRep);
 }
 
-namespace dcc
-{
-    void ISR_Dcc(void);
-}
-
 // ------------------------------------------------------------------------------------------------
 ///
 // ------------------------------------------------------------------------------------------------
@@ -283,9 +278,9 @@ TEST(Ut_Signal, ISR_Dcc1)
             bit_idx = 0;
         }
         t1 = micros();
-        dcc::ISR_Dcc();
+        dcc::decoder::get_instance().on_edge();
         hal::stubs::micros += tinc; // next bit after tinc us
-        dcc::ISR_Dcc();
+        dcc::decoder::get_instance().on_edge();
         t2 = micros() - t1;
         td += t2;
         hal::stubs::micros += tinc; // next bit after tinc us